@@ -0,0 +1,258 @@
+/**
+ * @file KernelBenchmark.cpp
+ * @date 19.10.2026
+ * @author Luis Gall
+ *
+ * Standalone benchmark of the FunctorKokkos variants. The SoAs are filled directly with synthetic particles and the
+ * SoA kernels are called without an AutoPas instance, so there is no container, tuning or traversal in the timed loop.
+ * Every variant is preceded by FunctorKokkosGeneric with the same options, which shows the gain of the specialization.
+ *
+ * Every kernel is first checked against the double-precision reference of Validation.h and only timed if its forces are
+ * within --forceTolerance. Both SoAs are checked, with newton3 the pair kernel also writes the reaction forces to soa2.
+ * The check runs on separate SoAs of at most --validationSize particles at the same density, and the references are
+ * computed once per size, cutoff and physics.
+ *
+ * Usage: AutoPasSimulatorKernelBenchmark [--sizes 1024,4096] [--cutoffs 2.5,3.5] [--density 0.8] [--repetitions 10] [--forceTolerance 1e-3] [--validationSize 2048]
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <map>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Random.hpp>
+
+#include "autopas/utils/Timer.h"
+
+#include <utils/Configuration.h>
+#include <utils/FunctorKokkos.h>
+#include <utils/FunctorKokkosGeneric.h>
+#include <utils/KernelVariants.h>
+#include <utils/KokkosParticle.h>
+#include <utils/Validation.h>
+
+#ifdef KOKKOS_ENABLE_CUDA
+using DeviceSpace = Kokkos::CudaSpace;
+#else
+using DeviceSpace = Kokkos::HostSpace;
+#endif
+
+using SoA = typename ParticleType::KokkosSoAArraysType;
+
+using FloatType = typename ParticleType::ParticleSoAFloatPrecision;
+
+namespace {
+
+    /**
+     * N owned particles uniformly distributed in [0, boxLength)^3, alternating types and charges, zero forces.
+     * Filled on the execution space of the kernels, so nothing has to be synchronized before the first launch.
+     */
+    SoA makeSoA(size_t N, double boxLength, uint64_t seed) {
+        SoA soa {};
+        soa.resize(N);
+
+        Kokkos::Random_XorShift64_Pool<DeviceSpace::execution_space> pool (seed);
+        Kokkos::parallel_for("fillSoA", Kokkos::RangePolicy<DeviceSpace::execution_space>(0, N), KOKKOS_LAMBDA(int i) {
+            auto generator = pool.get_state();
+            soa.template operator()<ParticleType::AttributeNames::id, true, false>(i) = i;
+            soa.template operator()<ParticleType::AttributeNames::posX, true, false>(i) = generator.drand(0., boxLength);
+            soa.template operator()<ParticleType::AttributeNames::posY, true, false>(i) = generator.drand(0., boxLength);
+            soa.template operator()<ParticleType::AttributeNames::posZ, true, false>(i) = generator.drand(0., boxLength);
+            pool.free_state(generator);
+
+            soa.template operator()<ParticleType::AttributeNames::forceX, true, false>(i) = 0.;
+            soa.template operator()<ParticleType::AttributeNames::forceY, true, false>(i) = 0.;
+            soa.template operator()<ParticleType::AttributeNames::forceZ, true, false>(i) = 0.;
+            soa.template operator()<ParticleType::AttributeNames::typeId, true, false>(i) = i % 2;
+            soa.template operator()<ParticleType::AttributeNames::mass, true, false>(i) = 1.;
+            soa.template operator()<ParticleType::AttributeNames::charge, true, false>(i) = i % 2 == 0 ? 1. : -1.;
+            soa.template operator()<ParticleType::AttributeNames::replicaId, true, false>(i) = 0;
+
+            using OwnershipType = std::remove_cvref_t<decltype(soa.template operator()<ParticleType::AttributeNames::ownershipState, true, false>(i))>;
+            soa.template operator()<ParticleType::AttributeNames::ownershipState, true, false>(i) = static_cast<OwnershipType>(autopas::OwnershipState::owned);
+        });
+        Kokkos::fence();
+        return soa;
+    }
+
+    void resetForces(const SoA& soa) {
+        Kokkos::parallel_for("resetForces", Kokkos::RangePolicy<DeviceSpace::execution_space>(0, soa.size()), KOKKOS_LAMBDA(int i) {
+            soa.template operator()<ParticleType::AttributeNames::forceX, true, false>(i) = 0.;
+            soa.template operator()<ParticleType::AttributeNames::forceY, true, false>(i) = 0.;
+            soa.template operator()<ParticleType::AttributeNames::forceZ, true, false>(i) = 0.;
+        });
+        Kokkos::fence();
+    }
+
+    /**
+     * Runs one launch on zeroed forces and compares the forces of both SoAs against their references. A reference with
+     * zero forces checks that the launch leaves that SoA untouched.
+     * @return largest force deviation relative to the RMS reference force of the respective SoA
+     */
+    template <class Launch>
+    double validateLaunch(const SoA& soa1, const SoA& soa2, const std::vector<utils::ReferenceParticle>& reference1,
+                          const std::vector<utils::ReferenceParticle>& reference2, Launch launch) {
+        resetForces(soa1);
+        resetForces(soa2);
+        launch();
+        Kokkos::fence();
+        const double error1 = utils::Validation::compareForces(reference1, utils::Validation::snapshot<DeviceSpace::execution_space>(soa1));
+        const double error2 = utils::Validation::compareForces(reference2, utils::Validation::snapshot<DeviceSpace::execution_space>(soa2));
+        resetForces(soa1);
+        resetForces(soa2);
+        return std::max(error1, error2);
+    }
+
+    /**
+     * Reference forces of one physics on the validation SoAs.
+     */
+    struct References {
+        std::vector<utils::ReferenceParticle> single;
+        std::vector<utils::ReferenceParticle> pair1;
+        // Reaction forces on soa2, only written by the pair kernel with newton3
+        std::vector<utils::ReferenceParticle> pair2;
+    };
+
+    std::vector<utils::ReferenceParticle> referenceForces(std::vector<utils::ReferenceParticle> targets, const std::vector<utils::ReferenceParticle>& sources,
+                                                          bool sameSet, const utils::ReferenceOptions& options) {
+        utils::Validation::computeForces(targets, sources, sameSet, options);
+        return targets;
+    }
+
+    /**
+     * Mean time of one fenced launch in seconds.
+     */
+    template <class Launch>
+    double timeLaunch(size_t repetitions, Launch launch) {
+        // Warm up, e.g. first touch and kernel loading
+        launch();
+        Kokkos::fence();
+
+        auto timer = autopas::utils::Timer();
+        for (size_t r = 0; r < repetitions; ++r) {
+            timer.start();
+            launch();
+            Kokkos::fence();
+            timer.stop();
+        }
+        return static_cast<double>(timer.getTotalTime()) * 1e-9 / static_cast<double>(repetitions);
+    }
+
+    /**
+     * Prints one CSV line with the timing of launch, or FAILED with the force error instead of numbers if validate fails.
+     */
+    template <class Launch, class Validate>
+    void benchmarkKernel(const std::string& kernel, const std::string& variant, size_t N, double cutoff, double pairs, double forceTolerance,
+                         size_t repetitions, Launch launch, Validate validate) {
+        std::cout << kernel << "," << variant << "," << N << "," << cutoff << ",";
+        const double forceError = validate();
+        if (not (forceError <= forceTolerance)) {
+            std::cout << "FAILED validation (force error " << forceError << ")," << std::endl;
+            return;
+        }
+        const double seconds = timeLaunch(repetitions, launch);
+        std::cout << seconds << "," << pairs / seconds << std::endl;
+    }
+
+}
+
+int main(int argc, char** argv) {
+
+    Kokkos::initialize(argc, argv);
+    {
+        // Same option syntax as the simulator, including --config files
+        auto options = Configuration::parseOptions(std::vector<std::string>(argv + 1, argv + argc));
+
+        const auto sizes = Configuration::parseList(options.contains("--sizes") ? options["--sizes"] : "1024,4096,16384");
+        const auto cutoffs = Configuration::parseList(options.contains("--cutoffs") ? options["--cutoffs"] : "2.5");
+        const double density = options.contains("--density") ? std::stod(options["--density"]) : 0.8;
+        const size_t repetitions = options.contains("--repetitions") ? std::stoul(options["--repetitions"]) : 10;
+        const double forceTolerance = options.contains("--forceTolerance") ? std::stod(options["--forceTolerance"]) : 1e-3;
+        const size_t validationSize = options.contains("--validationSize") ? std::stoul(options["--validationSize"]) : 2048;
+
+        // Two types for the MultiType variants
+        const std::vector<double> epsilons {1., 1.2};
+        const std::vector<double> sigmas {1., 1.1};
+        constexpr double ewaldAlpha = 1.;
+
+        std::cout << "kernel,variant,N,cutoff,seconds,pairs/s" << std::endl;
+
+        for (const auto numParticlesEntry : sizes) {
+            const auto N = static_cast<size_t>(numParticlesEntry);
+            const double boxLength = std::cbrt(static_cast<double>(N) / density);
+
+            const SoA soa1 = makeSoA(N, boxLength, 42);
+            const SoA soa2 = makeSoA(N, boxLength, 43);
+
+            // Validated on at most validationSize particles at the same density, the O(N^2) reference would dominate otherwise
+            const size_t validationN = std::min(N, validationSize);
+            const double validationBoxLength = std::cbrt(static_cast<double>(validationN) / density);
+            const SoA validationSoa1 = makeSoA(validationN, validationBoxLength, 42);
+            const SoA validationSoa2 = makeSoA(validationN, validationBoxLength, 43);
+            const auto particles1 = utils::Validation::snapshot<DeviceSpace::execution_space>(validationSoa1);
+            const auto particles2 = utils::Validation::snapshot<DeviceSpace::execution_space>(validationSoa2);
+
+            // Pair evaluations per launch, without newton3 the single kernel evaluates every pair twice but is counted once
+            const double pairsSingle = static_cast<double>(N) * static_cast<double>(N - 1) / 2.;
+            const double pairsPair = static_cast<double>(N) * static_cast<double>(N);
+
+            for (const auto cutoff : cutoffs) {
+
+                // The forces only depend on MultiType, Periodic and Coulomb, so all Newton3 and ComputeEnergy variants
+                // and the generic baseline of the same physics share one set of references
+                std::map<std::tuple<bool, bool, bool>, References> referenceCache {};
+                const auto references = [&](const utils::ReferenceOptions& options) -> const References& {
+                    const auto key = std::make_tuple(options.multiType, options.periodic, options.coulomb);
+                    auto cached = referenceCache.find(key);
+                    if (cached == referenceCache.end()) {
+                        cached = referenceCache.emplace(key, References{referenceForces(particles1, particles1, true, options),
+                                                                        referenceForces(particles1, particles2, false, options),
+                                                                        referenceForces(particles2, particles1, false, options)}).first;
+                    }
+                    return cached->second;
+                };
+
+                // Both launches of one functor on the full SoAs, validated with its twin on the validation SoAs
+                const auto benchmarkFunctor = [&](auto& functor, auto& validationFunctor, bool newton3, const References& reference) {
+                    // Without newton3 the pair kernel must leave soa2 untouched
+                    const auto& referencePair2 = newton3 ? reference.pair2 : particles2;
+                    benchmarkKernel("single", functor.getVariantName(), N, cutoff, pairsSingle, forceTolerance, repetitions,
+                        [&]() { functor.SoAFunctorSingleKokkos(soa1, newton3); },
+                        [&]() { return validateLaunch(validationSoa1, validationSoa2, reference.single, particles2,
+                                                      [&]() { validationFunctor.SoAFunctorSingleKokkos(validationSoa1, newton3); }); });
+                    benchmarkKernel("pair", functor.getVariantName(), N, cutoff, pairsPair, forceTolerance, repetitions,
+                        [&]() { functor.SoAFunctorPairKokkos(soa1, soa2, newton3); },
+                        [&]() { return validateLaunch(validationSoa1, validationSoa2, reference.pair1, referencePair2,
+                                                      [&]() { validationFunctor.SoAFunctorPairKokkos(validationSoa1, validationSoa2, newton3); }); });
+                };
+
+                // Every variant is preceded by FunctorKokkosGeneric with the same options, its runtime-branch baseline
+#define AUTOPASSIMULATOR_BENCHMARK_KERNEL_VARIANT(n3, e, mt, p, c)                                                             \
+                {                                                                                                             \
+                    using Functor = FunctorKokkos<ParticleType, DeviceSpace, n3, e, mt, p, c>;                               \
+                    using Generic = FunctorKokkosGeneric<ParticleType, DeviceSpace>;                                         \
+                    Functor functor (cutoff, boxLength, epsilons, sigmas, ewaldAlpha);                                       \
+                    Functor validationFunctor (cutoff, validationBoxLength, epsilons, sigmas, ewaldAlpha);                   \
+                    Generic generic (cutoff, boxLength, epsilons, sigmas, ewaldAlpha, n3, e, mt, p, c);                      \
+                    Generic validationGeneric (cutoff, validationBoxLength, epsilons, sigmas, ewaldAlpha, n3, e, mt, p, c);  \
+                    const auto& reference = references(                                                                      \
+                        utils::Validation::makeOptions<Functor>(cutoff, validationBoxLength, epsilons, sigmas, ewaldAlpha)); \
+                    benchmarkFunctor(generic, validationGeneric, n3, reference);                                             \
+                    benchmarkFunctor(functor, validationFunctor, n3, reference);                                             \
+                }
+
+                AUTOPASSIMULATOR_FOR_EACH_KERNEL_VARIANT(AUTOPASSIMULATOR_BENCHMARK_KERNEL_VARIANT)
+
+#undef AUTOPASSIMULATOR_BENCHMARK_KERNEL_VARIANT
+            }
+        }
+    }
+    Kokkos::finalize();
+
+    return 0;
+}
@@ -1,14 +1,31 @@
+#include <algorithm>
+#include <exception>
+#include <fstream>
 #include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include <autopas/AutoPasDecl.h>
 
 
 #include <utils/KokkosParticle.h>
 #include <utils/FunctorKokkos.h>
+#include <utils/KernelVariants.h>
+#include <utils/FunctorAxilrodTellerKokkos.h>
 #include <utils/Setup.h>
+#include <utils/LaunchCounter.h>
+#include <utils/Analysis.h>
+#include <utils/Validation.h>
+#include <utils/RunRecord.h>
+#ifndef KOKKOS_ENABLE_CUDA
+#include <utils/SPME.h>
+#endif
 #include "utils/Configuration.h"
 
-extern template class autopas::AutoPas<KokkosParticle>;
+extern template class autopas::AutoPas<ParticleType>;
 
 #ifdef KOKKOS_ENABLE_CUDA
 using DeviceSpace = Kokkos::CudaSpace;
@@ -21,61 +38,385 @@ constexpr bool forEachHostFlag = true;
 #endif
 
 template <class ReturnType, class FunctionType>
-ReturnType applyWithChosenFunctor(FunctionType f) {
-#ifdef KOKKOS_ENABLE_CUDA
-    return f(FunctorKokkos<KokkosParticle, DeviceSpace>{3.});
-#else
-    return f(FunctorKokkos<KokkosParticle, DeviceSpace>{3.});
-#endif
+ReturnType applyWithChosenFunctor(utils::KernelVariant<DeviceSpace>& chosenFunctor, FunctionType f) {
+    return utils::KernelVariants::apply<ReturnType>(chosenFunctor, f);
 }
 
-int main(int argc, char** argv) {
-
-    autopas::AutoPas_MPI_Init(&argc, &argv);
-    autopas::AutoPas_Kokkos_Init(argc, argv);
-    {
-        Configuration config {};
-        config.parseConfig(argc, argv);
-        autopas::AutoPas<KokkosParticle> autoPasInstance = autopas::AutoPas<KokkosParticle>(std::cout);
-
-        std::cout << typeid(KokkosParticle::ParticleSoAFloatPrecision).name() << std::endl;
+template <class ReturnType, class FunctionType>
+ReturnType applyWithChosenTriwiseFunctor(FunctionType f, const Configuration& config) {
+    return f(FunctorAxilrodTellerKokkos<ParticleType, DeviceSpace>{config.getCutoff(), config.getNu()});
+}
 
+/**
+ * One simulation with the given configuration.
+ * @param reuseInstance autoPasInstance is already initialized with compatible options, only its particles are replaced
+ * @param record filled with the results of the run
+ * @return false if the validation failed
+ */
+bool runSimulation(const Configuration& config, autopas::AutoPas<ParticleType>& autoPasInstance, bool reuseInstance, utils::RunRecord& record) {
+
+    std::cout << typeid(ParticleType::ParticleSoAFloatPrecision).name() << std::endl;
+    utils::Setup::printMemoryUsage(config);
+
+    if (reuseInstance) {
+        // Keeps the initialized container and its storage, only the particles are replaced
+        autoPasInstance.deleteAllParticles();
+    } else {
         // TODO: options for disabling tuning completely
         utils::Setup::provideOptions(autoPasInstance, config);
         autoPasInstance.init();
-        autoPasInstance.reserve(config.getNumParticles(), config.getNumHalos());
-        utils::Setup::fillParticles(autoPasInstance, config);
+    }
+    autoPasInstance.reserve(config.getNumReplicas() * config.getNumParticles(), config.getNumReplicas() * config.getNumHalos());
+    utils::Setup::fillParticles(autoPasInstance, config);
+
+    // Picked once, the inner loops of the chosen instantiation carry no branches for these options
+    auto chosenFunctor = utils::KernelVariants::choose<DeviceSpace>(config);
+    applyWithChosenFunctor<void>(chosenFunctor, [](auto& functor) { std::cout << "Kernel: " << functor.getVariantName() << std::endl; });
+
+    const auto resetForces = [&]() {
+        autoPasInstance.forEachKokkos<ForEachSpace::execution_space>(KOKKOS_LAMBDA(int i, const autopas::utils::KokkosStorage<ParticleType>& storage) {
+            storage.operator()<ParticleType::AttributeNames::forceX, true, forEachHostFlag>(i) = 0.;
+            storage.operator()<ParticleType::AttributeNames::forceY, true, forEachHostFlag>(i) = 0.;
+            storage.operator()<ParticleType::AttributeNames::forceZ, true, forEachHostFlag>(i) = 0.;
+        }, autopas::IteratorBehavior::ownedOrHalo);
+    };
+
+    // Validation against the serial double-precision reference, also gates the kernel benchmark
+    const size_t numIds = config.getNumReplicas() * (config.getNumParticles() + config.getNumHalos());
+    const auto takeSnapshot = [&]() {
+        return utils::Validation::snapshot<ForEachSpace::execution_space, forEachHostFlag>(autoPasInstance, numIds);
+    };
+    const auto referenceOptions = [&](const auto& functor) {
+        return utils::Validation::makeOptions<std::decay_t<decltype(functor)>>(config.getCutoff(), config.getBoxMax() - config.getBoxMin(),
+                                                                             config.getEpsilons(), config.getSigmas(), config.getEwaldAlpha());
+    };
+
+    std::vector<utils::ReferenceParticle> initialState {};
+    if (config.getValidate() or config.getBenchmarkKernelRepetitions() > 0) {
+        initialState = takeSnapshot();
+    }
+
+    // Checks the energy too if checkEnergy, the options are those of the physics the functor computes
+    const auto validateKernelWith = [&](auto& functor, const utils::ReferenceOptions& options, bool checkEnergy) {
+        auto reference = initialState;
+        const double referenceEnergy = utils::Validation::computeForces(reference, options);
+
+        resetForces();
+        autoPasInstance.computeInteractions(&functor);
+        const auto actual = takeSnapshot();
+        resetForces();
+
+        const double forceError = utils::Validation::compareForces(reference, actual);
+        bool passed = forceError <= config.getForceTolerance();
+        std::cout << "Validation " << functor.getVariantName() << ": force error " << forceError;
+        if (checkEnergy) {
+            const double energyError = utils::Validation::relativeError(referenceEnergy, functor.getPotentialEnergy());
+            passed = passed and energyError <= config.getEnergyTolerance();
+            std::cout << ", energy error " << energyError;
+        }
+        std::cout << (passed ? ", passed" : ", FAILED") << std::endl;
+        return passed;
+    };
+
+    const auto validateKernel = [&](auto& functor) {
+        return validateKernelWith(functor, referenceOptions(functor), std::decay_t<decltype(functor)>::usesComputeEnergy);
+    };
+
+    bool validationPassed = true;
+    if (config.getValidate()) {
+        validationPassed = applyWithChosenFunctor<bool>(chosenFunctor, validateKernel);
+
+        if (config.getAnalysisInterval() > 0) {
+            // The histograms have to accumulate: two samples of the same state give exactly twice the counts of one
+            utils::InSituAnalysis<DeviceSpace> analysisCheck (config);
+            analysisCheck.sample(autoPasInstance);
+            const auto once = analysisCheck.getTotalCounts();
+            analysisCheck.sample(autoPasInstance);
+            const auto twice = analysisCheck.getTotalCounts();
+            const bool analysisPassed = twice[0] == 2. * once[0] and twice[1] == 2. * once[1] and twice[2] == 2. * once[2];
+            std::cout << "Validation analysis: counts after one sample " << once[0] << "/" << once[1] << "/" << once[2]
+                      << ", after two " << twice[0] << "/" << twice[1] << "/" << twice[2] << (analysisPassed ? ", passed" : ", FAILED") << std::endl;
+            validationPassed = validationPassed and analysisPassed;
+        }
+
+#ifndef KOKKOS_ENABLE_CUDA
+        if (config.getSpme()) {
+            // Reciprocal part only, against the direct Ewald sum over the wave vectors. A separate SPME instance keeps
+            // the check out of the timers of the run.
+            utils::SPME spmeCheck (config.getSpmeGridSize(), config.getSpmeSplineOrder(), config.getEwaldAlpha(), config.getBoxMin(), config.getBoxMax() - config.getBoxMin());
+            auto reference = initialState;
+            for (auto& p : reference) {
+                p.f = {0., 0., 0.};
+            }
+            const auto options = applyWithChosenFunctor<utils::ReferenceOptions>(chosenFunctor, referenceOptions);
+            const double referenceEnergy = utils::Validation::addReciprocalForces(reference, options);
+
+            resetForces();
+            const double energy = spmeCheck.computeForces(autoPasInstance);
+            const auto actual = takeSnapshot();
+            resetForces();
+
+            const double forceError = utils::Validation::compareForces(reference, actual);
+            const double energyError = utils::Validation::relativeError(referenceEnergy, energy);
+            const bool spmePassed = forceError <= config.getSpmeTolerance() and energyError <= config.getSpmeTolerance();
+            std::cout << "Validation SPME: force error " << forceError << ", energy error " << energyError << (spmePassed ? ", passed" : ", FAILED") << std::endl;
+            validationPassed = validationPassed and spmePassed;
+        }
+#endif
+
+        if (config.getTriwise()) {
+            // Triwise kernel only, against the serial triplet sum
+            auto reference = initialState;
+            for (auto& p : reference) {
+                p.f = {0., 0., 0.};
+            }
+            auto options = applyWithChosenFunctor<utils::ReferenceOptions>(chosenFunctor, referenceOptions);
+            options.nu = config.getNu();
+            utils::Validation::addTriwiseForces(reference, options);
+
+            resetForces();
+            applyWithChosenTriwiseFunctor<bool>([&](auto && functor) { return autoPasInstance.computeInteractions(&functor); }, config);
+            const auto actual = takeSnapshot();
+            resetForces();
+
+            const double forceError = utils::Validation::compareForces(reference, actual);
+            const bool triwisePassed = forceError <= config.getForceTolerance();
+            std::cout << "Validation FunctorAxilrodTellerKokkos: force error " << forceError << (triwisePassed ? ", passed" : ", FAILED") << std::endl;
+            validationPassed = validationPassed and triwisePassed;
+        }
+    }
+
+    if (config.getBenchmarkKernelRepetitions() > 0) {
+        const auto benchmarkKernel = [&](auto& functor, bool passed) {
+            // Numbers of a kernel computing wrong forces are meaningless
+            if (not passed) {
+                std::cout << functor.getVariantName() << ": not reported, failed validation" << std::endl;
+                return;
+            }
+
+            auto kernelTimer = autopas::utils::Timer();
+            for (size_t r = 0; r < config.getBenchmarkKernelRepetitions(); ++r) {
+                kernelTimer.start();
+                autoPasInstance.computeInteractions(&functor);
+                Kokkos::fence();
+                kernelTimer.stop();
+            }
+            std::cout << functor.getVariantName() << ": " << kernelTimer.getTotalTime() / config.getBenchmarkKernelRepetitions() << " ns per force computation" << std::endl;
+        };
+
+        // Baseline first: the same physics as the chosen variant, with runtime branches instead of template parameters
+        auto generic = utils::KernelVariants::generic<DeviceSpace>(config);
+        benchmarkKernel(generic, validateKernelWith(generic, applyWithChosenFunctor<utils::ReferenceOptions>(chosenFunctor, referenceOptions), config.getComputeEnergy()));
 
-        auto positionTimer = autopas::utils::Timer();
-        auto interactionsTimer = autopas::utils::Timer();
-        auto velocityTimer = autopas::utils::Timer();
+        utils::KernelVariants::forEachCompatible<DeviceSpace>(config, [&](auto&& functor) {
+            benchmarkKernel(functor, validateKernel(functor));
+        });
 
-        double deltaT = config.getDeltaT();
-        size_t iterations = config.getNumIterations();
+        // The benchmark accumulated forces, the simulation has to start from zero
+        resetForces();
+    }
+
+    auto positionTimer = autopas::utils::Timer();
+    auto interactionsTimer = autopas::utils::Timer();
+    auto velocityTimer = autopas::utils::Timer();
+    auto triwiseTimer = autopas::utils::Timer();
+
+    size_t iterations = config.getNumIterations();
+    const size_t numReplicas = config.getNumReplicas();
+
+    // Per replica time step widths, looked up by the replica id of each particle
+    Kokkos::View<double*, DeviceSpace> replicaDeltaT ("replicaDeltaT", numReplicas);
+    {
+        auto replicaDeltaTHost = Kokkos::create_mirror_view(replicaDeltaT);
+        for (size_t r = 0; r < numReplicas; ++r) {
+            replicaDeltaTHost(r) = config.getDeltaT(r);
+        }
+        Kokkos::deep_copy(replicaDeltaT, replicaDeltaTHost);
+    }
+
+    // Reciprocal-space part of the Ewald sum, the grid operations only exist on the host backends
+    auto longRangeTimer = autopas::utils::Timer();
+    double reciprocalEnergy = 0.;
+#ifndef KOKKOS_ENABLE_CUDA
+    std::optional<utils::SPME> spme {};
+    if (config.getSpme()) {
+        spme.emplace(config.getSpmeGridSize(), config.getSpmeSplineOrder(), config.getEwaldAlpha(), config.getBoxMin(), config.getBoxMax() - config.getBoxMin());
+    }
+#else
+    if (config.getSpme()) {
+        throw std::invalid_argument("SPME is only available on the host backends");
+    }
+#endif
+    const auto computeLongRange = [&]() {
+#ifndef KOKKOS_ENABLE_CUDA
+        if (spme) {
+            reciprocalEnergy = spme->computeForces(autoPasInstance);
+        }
+#endif
+    };
+
+    // Sampled every analysisInterval steps on the execution space, only the histograms leave it at the end
+    std::optional<utils::InSituAnalysis<DeviceSpace>> analysis {};
+    if (config.getAnalysisInterval() > 0) {
+        analysis.emplace(config);
+    }
+    size_t analysisStep = 0;
+    const auto sampleAnalysis = [&]() {
+        if (analysis and ++analysisStep % config.getAnalysisInterval() == 0) {
+            analysis->sample(autoPasInstance);
+        }
+    };
+
+    // Positions for the trajectory check, taken after the first trajectorySteps steps
+    const size_t trajectorySteps = std::min<size_t>(config.getTrajectorySteps(), iterations);
+    std::vector<utils::ReferenceParticle> trajectoryState {};
+    // Kernel launches of all steps, counted through global Kokkos Tools callbacks, therefore only on request
+    std::optional<utils::LaunchCounter> launchCounter {};
+    if (config.getCountLaunches()) {
+        launchCounter.emplace();
+    }
+
+    const auto checkpointTrajectory = [&](size_t step) {
+        if (config.getValidate() and step == trajectorySteps) {
+            if (launchCounter) {
+                launchCounter->suspend();
+            }
+            trajectoryState = takeSnapshot();
+            if (launchCounter) {
+                launchCounter->resume();
+            }
+        }
+    };
+
+    auto totalTimer = autopas::utils::Timer();
+    totalTimer.start();
+
+    if (config.getFusedStep()) {
+        // Kick/drift fusion: the half kick of step i and the drift of step i + 1 are one launch, so a step is one
+        // integration launch plus the force kernels, without fences in between.
+        bool kickPending = false;
+        const auto integrate = [&](bool kick, bool drift) {
+            autoPasInstance.forEachKokkos<ForEachSpace::execution_space>(KOKKOS_LAMBDA(int i, const autopas::utils::KokkosStorage<ParticleType>& storage) {
+
+                const double deltaT = replicaDeltaT(storage.operator()<ParticleType::AttributeNames::replicaId, true, forEachHostFlag>(i));
+                const typename ParticleType::ParticleSoAFloatPrecision mass = storage.operator()<ParticleType::AttributeNames::mass, true, forEachHostFlag>(i);
+
+                typename ParticleType::ParticleSoAFloatPrecision vX = storage.operator()<ParticleType::AttributeNames::velocityX, true, forEachHostFlag>(i);
+                typename ParticleType::ParticleSoAFloatPrecision vY = storage.operator()<ParticleType::AttributeNames::velocityY, true, forEachHostFlag>(i);
+                typename ParticleType::ParticleSoAFloatPrecision vZ = storage.operator()<ParticleType::AttributeNames::velocityZ, true, forEachHostFlag>(i);
+
+                const typename ParticleType::ParticleSoAFloatPrecision fX = storage.operator()<ParticleType::AttributeNames::forceX, true, forEachHostFlag>(i);
+                const typename ParticleType::ParticleSoAFloatPrecision fY = storage.operator()<ParticleType::AttributeNames::forceY, true, forEachHostFlag>(i);
+                const typename ParticleType::ParticleSoAFloatPrecision fZ = storage.operator()<ParticleType::AttributeNames::forceZ, true, forEachHostFlag>(i);
+
+                // Half kick with the forces of the previous step
+                if (kick) {
+                    vX += (fX + storage.operator()<ParticleType::AttributeNames::oldForceX, true, forEachHostFlag>(i)) * (deltaT / (2 * mass));
+                    vY += (fY + storage.operator()<ParticleType::AttributeNames::oldForceY, true, forEachHostFlag>(i)) * (deltaT / (2 * mass));
+                    vZ += (fZ + storage.operator()<ParticleType::AttributeNames::oldForceZ, true, forEachHostFlag>(i)) * (deltaT / (2 * mass));
+
+                    storage.operator()<ParticleType::AttributeNames::velocityX, true, forEachHostFlag>(i) = vX;
+                    storage.operator()<ParticleType::AttributeNames::velocityY, true, forEachHostFlag>(i) = vY;
+                    storage.operator()<ParticleType::AttributeNames::velocityZ, true, forEachHostFlag>(i) = vZ;
+                }
+
+                // Drift and force reset of the next step
+                if (drift) {
+                    storage.operator()<ParticleType::AttributeNames::oldForceX, true, forEachHostFlag>(i) = fX;
+                    storage.operator()<ParticleType::AttributeNames::oldForceY, true, forEachHostFlag>(i) = fY;
+                    storage.operator()<ParticleType::AttributeNames::oldForceZ, true, forEachHostFlag>(i) = fZ;
+
+                    storage.operator()<ParticleType::AttributeNames::forceX, true, forEachHostFlag>(i) = 0.;
+                    storage.operator()<ParticleType::AttributeNames::forceY, true, forEachHostFlag>(i) = 0.;
+                    storage.operator()<ParticleType::AttributeNames::forceZ, true, forEachHostFlag>(i) = 0.;
+
+                    storage.operator()<ParticleType::AttributeNames::posX, true, forEachHostFlag>(i) += vX * deltaT + fX * (deltaT * deltaT / (2 * mass));
+                    storage.operator()<ParticleType::AttributeNames::posY, true, forEachHostFlag>(i) += vY * deltaT + fY * (deltaT * deltaT / (2 * mass));
+                    storage.operator()<ParticleType::AttributeNames::posZ, true, forEachHostFlag>(i) += vZ * deltaT + fZ * (deltaT * deltaT / (2 * mass));
+                }
 
+            }, autopas::IteratorBehavior::owned);
+        };
+
+        // Only with --timeFusedStepPhases every phase is fenced, otherwise the launches of a step are not separated
+        const bool timePhases = config.getTimeFusedStepPhases();
+        const auto runPhase = [&](autopas::utils::Timer& timer, const auto& phase) {
+            if (timePhases) {
+                timer.start();
+                phase();
+                Kokkos::fence();
+                timer.stop();
+            } else {
+                phase();
+            }
+        };
+
+        auto stepTimer = autopas::utils::Timer();
+        for (int i = 0; i < iterations; i++) {
+            stepTimer.start();
+            runPhase(positionTimer, [&]() { integrate(kickPending, true); });
+            kickPending = true;
+            runPhase(interactionsTimer, [&]() {
+                applyWithChosenFunctor<bool>(chosenFunctor, [&](auto && functor) { return autoPasInstance.computeInteractions(&functor); });
+            });
+            // Accumulates into the same force columns, therefore after the pairwise kernel
+            if (config.getTriwise()) {
+                runPhase(triwiseTimer, [&]() {
+                    applyWithChosenTriwiseFunctor<bool>([&](auto && functor) { return autoPasInstance.computeInteractions(&functor); }, config);
+                });
+            }
+            if (config.getSpme()) {
+                runPhase(longRangeTimer, computeLongRange);
+            }
+            // Samples positions of this step with velocities still half a kick behind
+            sampleAnalysis();
+            Kokkos::fence();
+            stepTimer.stop();
+            // Positions are complete after the drift, only the velocities lag half a kick behind
+            checkpointTrajectory(i + 1);
+        }
+
+        // Closing half kick of the last step
+        if (kickPending) {
+            integrate(true, false);
+        }
+
+        std::cout << "Fused step: " << (iterations > 0 ? stepTimer.getTotalTime() / iterations : 0) << " ns per step" << std::endl;
+        if (timePhases and iterations > 0) {
+            std::cout << "  Kick Drift: " << positionTimer.getTotalTime() / iterations << " ns per step" << std::endl;
+            std::cout << "  Force Kernel: " << interactionsTimer.getTotalTime() / iterations << " ns per step" << std::endl;
+            if (config.getTriwise()) {
+                std::cout << "  Triwise Force Kernel: " << triwiseTimer.getTotalTime() / iterations << " ns per step" << std::endl;
+            }
+            if (config.getSpme()) {
+                std::cout << "  Long Range: " << longRangeTimer.getTotalTime() / iterations << " ns per step" << std::endl;
+            }
+        }
+    } else {
         for (int i = 0; i < iterations; i++) {
             // 1. Position Update and Force reset
             positionTimer.start();
             Kokkos::Profiling::pushRegion("Position Update");
-            autoPasInstance.forEachKokkos<ForEachSpace::execution_space>(KOKKOS_LAMBDA(int i, const autopas::utils::KokkosStorage<KokkosParticle>& storage) {
+            autoPasInstance.forEachKokkos<ForEachSpace::execution_space>(KOKKOS_LAMBDA(int i, const autopas::utils::KokkosStorage<ParticleType>& storage) {
 
-                const typename KokkosParticle::ParticleSoAFloatPrecision mass = storage.operator()<KokkosParticle::AttributeNames::mass, true, forEachHostFlag>(i);
-                typename KokkosParticle::ParticleSoAFloatPrecision vX = storage.operator()<KokkosParticle::AttributeNames::velocityX, true, forEachHostFlag>(i);
-                typename KokkosParticle::ParticleSoAFloatPrecision vY = storage.operator()<KokkosParticle::AttributeNames::velocityY, true, forEachHostFlag>(i);
-                typename KokkosParticle::ParticleSoAFloatPrecision vZ = storage.operator()<KokkosParticle::AttributeNames::velocityZ, true, forEachHostFlag>(i);
+                const double deltaT = replicaDeltaT(storage.operator()<ParticleType::AttributeNames::replicaId, true, forEachHostFlag>(i));
+                const typename ParticleType::ParticleSoAFloatPrecision mass = storage.operator()<ParticleType::AttributeNames::mass, true, forEachHostFlag>(i);
+                typename ParticleType::ParticleSoAFloatPrecision vX = storage.operator()<ParticleType::AttributeNames::velocityX, true, forEachHostFlag>(i);
+                typename ParticleType::ParticleSoAFloatPrecision vY = storage.operator()<ParticleType::AttributeNames::velocityY, true, forEachHostFlag>(i);
+                typename ParticleType::ParticleSoAFloatPrecision vZ = storage.operator()<ParticleType::AttributeNames::velocityZ, true, forEachHostFlag>(i);
 
-                typename KokkosParticle::ParticleSoAFloatPrecision fX = storage.operator()<KokkosParticle::AttributeNames::forceX, true, forEachHostFlag>(i);
-                typename KokkosParticle::ParticleSoAFloatPrecision fY = storage.operator()<KokkosParticle::AttributeNames::forceY, true, forEachHostFlag>(i);
-                typename KokkosParticle::ParticleSoAFloatPrecision fZ = storage.operator()<KokkosParticle::AttributeNames::forceZ, true, forEachHostFlag>(i);
+                typename ParticleType::ParticleSoAFloatPrecision fX = storage.operator()<ParticleType::AttributeNames::forceX, true, forEachHostFlag>(i);
+                typename ParticleType::ParticleSoAFloatPrecision fY = storage.operator()<ParticleType::AttributeNames::forceY, true, forEachHostFlag>(i);
+                typename ParticleType::ParticleSoAFloatPrecision fZ = storage.operator()<ParticleType::AttributeNames::forceZ, true, forEachHostFlag>(i);
 
-                storage.operator()<KokkosParticle::AttributeNames::oldForceX, true, forEachHostFlag>(i) = fX;
-                storage.operator()<KokkosParticle::AttributeNames::oldForceY, true, forEachHostFlag>(i) = fY;
-                storage.operator()<KokkosParticle::AttributeNames::oldForceZ, true, forEachHostFlag>(i) = fZ;
+                storage.operator()<ParticleType::AttributeNames::oldForceX, true, forEachHostFlag>(i) = fX;
+                storage.operator()<ParticleType::AttributeNames::oldForceY, true, forEachHostFlag>(i) = fY;
+                storage.operator()<ParticleType::AttributeNames::oldForceZ, true, forEachHostFlag>(i) = fZ;
 
                 // No global force, therefore 0
-                storage.operator()<KokkosParticle::AttributeNames::forceX, true, forEachHostFlag>(i) = 5.;
-                storage.operator()<KokkosParticle::AttributeNames::forceY, true, forEachHostFlag>(i) = 5.;
-                storage.operator()<KokkosParticle::AttributeNames::forceZ, true, forEachHostFlag>(i) = 5.;
+                storage.operator()<ParticleType::AttributeNames::forceX, true, forEachHostFlag>(i) = 0.;
+                storage.operator()<ParticleType::AttributeNames::forceY, true, forEachHostFlag>(i) = 0.;
+                storage.operator()<ParticleType::AttributeNames::forceZ, true, forEachHostFlag>(i) = 0.;
 
                 vX *= deltaT;
                 vY *= deltaT;
@@ -85,13 +426,13 @@ int main(int argc, char** argv) {
                 fY *= (deltaT * deltaT / (2 * mass));
                 fZ *= (deltaT * deltaT / (2 * mass));
 
-                const typename KokkosParticle::ParticleSoAFloatPrecision displacementX = vX + fX;
-                const typename KokkosParticle::ParticleSoAFloatPrecision displacementY = vY + fY;
-                const typename KokkosParticle::ParticleSoAFloatPrecision displacementZ = vZ + fZ;
+                const typename ParticleType::ParticleSoAFloatPrecision displacementX = vX + fX;
+                const typename ParticleType::ParticleSoAFloatPrecision displacementY = vY + fY;
+                const typename ParticleType::ParticleSoAFloatPrecision displacementZ = vZ + fZ;
 
-                storage.operator()<KokkosParticle::AttributeNames::posX, true, forEachHostFlag>(i) = displacementX + storage.operator()<KokkosParticle::AttributeNames::posX, true, forEachHostFlag>(i);
-                storage.operator()<KokkosParticle::AttributeNames::posY, true, forEachHostFlag>(i) = displacementY + storage.operator()<KokkosParticle::AttributeNames::posY, true, forEachHostFlag>(i);
-                storage.operator()<KokkosParticle::AttributeNames::posZ, true, forEachHostFlag>(i) = displacementZ + storage.operator()<KokkosParticle::AttributeNames::posZ, true, forEachHostFlag>(i);
+                storage.operator()<ParticleType::AttributeNames::posX, true, forEachHostFlag>(i) = displacementX + storage.operator()<ParticleType::AttributeNames::posX, true, forEachHostFlag>(i);
+                storage.operator()<ParticleType::AttributeNames::posY, true, forEachHostFlag>(i) = displacementY + storage.operator()<ParticleType::AttributeNames::posY, true, forEachHostFlag>(i);
+                storage.operator()<ParticleType::AttributeNames::posZ, true, forEachHostFlag>(i) = displacementZ + storage.operator()<ParticleType::AttributeNames::posZ, true, forEachHostFlag>(i);
 
             }, autopas::IteratorBehavior::owned);
             Kokkos::Profiling::popRegion();
@@ -100,9 +441,28 @@ int main(int argc, char** argv) {
             // 2. Compute particle interactions based on the defined functor
             interactionsTimer.start();
             Kokkos::Profiling::pushRegion("Force Kernel");
-            applyWithChosenFunctor<bool>([&](auto && functor) { return autoPasInstance.computeInteractions(&functor); });
+            applyWithChosenFunctor<bool>(chosenFunctor, [&](auto && functor) { return autoPasInstance.computeInteractions(&functor); });
+            Kokkos::Profiling::popRegion();
             interactionsTimer.stop();
 
+            // 2b. Three-body interactions on top of the pairwise ones
+            if (config.getTriwise()) {
+                triwiseTimer.start();
+                Kokkos::Profiling::pushRegion("Triwise Force Kernel");
+                applyWithChosenTriwiseFunctor<bool>([&](auto && functor) { return autoPasInstance.computeInteractions(&functor); }, config);
+                Kokkos::Profiling::popRegion();
+                triwiseTimer.stop();
+            }
+
+            // 2c. Reciprocal-space Coulomb forces
+            if (config.getSpme()) {
+                longRangeTimer.start();
+                Kokkos::Profiling::pushRegion("Long Range");
+                computeLongRange();
+                Kokkos::Profiling::popRegion();
+                longRangeTimer.stop();
+            }
+
             /*
             bool test = false;
             autoPasInstance.reduceKokkos<ForEachSpace::execution_space, bool, Kokkos::LOr<bool>>(KOKKOS_LAMBDA(int i, const autopas::utils::KokkosStorage<ParticleType>& storage, bool& local) {
@@ -114,30 +474,36 @@ int main(int argc, char** argv) {
             // 3. Velocity update
             velocityTimer.start();
             Kokkos::Profiling::pushRegion("Velocity Update");
-            autoPasInstance.forEachKokkos<ForEachSpace::execution_space>(KOKKOS_LAMBDA(int i, const autopas::utils::KokkosStorage<KokkosParticle>& storage) {
+            autoPasInstance.forEachKokkos<ForEachSpace::execution_space>(KOKKOS_LAMBDA(int i, const autopas::utils::KokkosStorage<ParticleType>& storage) {
 
-                const typename KokkosParticle::ParticleSoAFloatPrecision mass = storage.operator()<KokkosParticle::AttributeNames::mass, true, forEachHostFlag>(i);
+                const double deltaT = replicaDeltaT(storage.operator()<ParticleType::AttributeNames::replicaId, true, forEachHostFlag>(i));
+                const typename ParticleType::ParticleSoAFloatPrecision mass = storage.operator()<ParticleType::AttributeNames::mass, true, forEachHostFlag>(i);
 
-                const typename KokkosParticle::ParticleSoAFloatPrecision fX = storage.operator()<KokkosParticle::AttributeNames::forceX, true, forEachHostFlag>(i);
-                const typename KokkosParticle::ParticleSoAFloatPrecision fY = storage.operator()<KokkosParticle::AttributeNames::forceY, true, forEachHostFlag>(i);
-                const typename KokkosParticle::ParticleSoAFloatPrecision fZ = storage.operator()<KokkosParticle::AttributeNames::forceZ, true, forEachHostFlag>(i);
+                const typename ParticleType::ParticleSoAFloatPrecision fX = storage.operator()<ParticleType::AttributeNames::forceX, true, forEachHostFlag>(i);
+                const typename ParticleType::ParticleSoAFloatPrecision fY = storage.operator()<ParticleType::AttributeNames::forceY, true, forEachHostFlag>(i);
+                const typename ParticleType::ParticleSoAFloatPrecision fZ = storage.operator()<ParticleType::AttributeNames::forceZ, true, forEachHostFlag>(i);
 
-                const typename KokkosParticle::ParticleSoAFloatPrecision oldFx = storage.operator()<KokkosParticle::AttributeNames::oldForceX, true, forEachHostFlag>(i);
-                const typename KokkosParticle::ParticleSoAFloatPrecision oldFy = storage.operator()<KokkosParticle::AttributeNames::oldForceY, true, forEachHostFlag>(i);
-                const typename KokkosParticle::ParticleSoAFloatPrecision oldFz = storage.operator()<KokkosParticle::AttributeNames::oldForceZ, true, forEachHostFlag>(i);
+                const typename ParticleType::ParticleSoAFloatPrecision oldFx = storage.operator()<ParticleType::AttributeNames::oldForceX, true, forEachHostFlag>(i);
+                const typename ParticleType::ParticleSoAFloatPrecision oldFy = storage.operator()<ParticleType::AttributeNames::oldForceY, true, forEachHostFlag>(i);
+                const typename ParticleType::ParticleSoAFloatPrecision oldFz = storage.operator()<ParticleType::AttributeNames::oldForceZ, true, forEachHostFlag>(i);
 
-                const typename KokkosParticle::ParticleSoAFloatPrecision vUpdateX = (fX + oldFx) * (deltaT / (2 * mass));
-                const typename KokkosParticle::ParticleSoAFloatPrecision vUpdateY = (fY + oldFy) * (deltaT / (2 * mass));
-                const typename KokkosParticle::ParticleSoAFloatPrecision vUpdateZ = (fZ + oldFz) * (deltaT / (2 * mass));
+                const typename ParticleType::ParticleSoAFloatPrecision vUpdateX = (fX + oldFx) * (deltaT / (2 * mass));
+                const typename ParticleType::ParticleSoAFloatPrecision vUpdateY = (fY + oldFy) * (deltaT / (2 * mass));
+                const typename ParticleType::ParticleSoAFloatPrecision vUpdateZ = (fZ + oldFz) * (deltaT / (2 * mass));
 
-                storage.operator()<KokkosParticle::AttributeNames::velocityX, true, forEachHostFlag>(i) = vUpdateX + storage.operator()<KokkosParticle::AttributeNames::velocityX, true, forEachHostFlag>(i);
-                storage.operator()<KokkosParticle::AttributeNames::velocityY, true, forEachHostFlag>(i) = vUpdateY + storage.operator()<KokkosParticle::AttributeNames::velocityX, true, forEachHostFlag>(i);
-                storage.operator()<KokkosParticle::AttributeNames::velocityZ, true, forEachHostFlag>(i) = vUpdateZ + storage.operator()<KokkosParticle::AttributeNames::velocityX, true, forEachHostFlag>(i);
+                storage.operator()<ParticleType::AttributeNames::velocityX, true, forEachHostFlag>(i) = vUpdateX + storage.operator()<ParticleType::AttributeNames::velocityX, true, forEachHostFlag>(i);
+                storage.operator()<ParticleType::AttributeNames::velocityY, true, forEachHostFlag>(i) = vUpdateY + storage.operator()<ParticleType::AttributeNames::velocityY, true, forEachHostFlag>(i);
+                storage.operator()<ParticleType::AttributeNames::velocityZ, true, forEachHostFlag>(i) = vUpdateZ + storage.operator()<ParticleType::AttributeNames::velocityZ, true, forEachHostFlag>(i);
 
             }, autopas::IteratorBehavior::owned);
             Kokkos::Profiling::popRegion();
             velocityTimer.stop();
 
+            // 4. In-situ analysis
+            sampleAnalysis();
+
+            checkpointTrajectory(i + 1);
+
 
             /*
             for (auto p = autoPasInstance.begin(autopas::IteratorBehavior::owned); p.isValid(); ++p) {
@@ -147,15 +513,274 @@ int main(int argc, char** argv) {
             */
 
         }
+    }
+    Kokkos::fence();
+    totalTimer.stop();
+
+    // Per step overhead: compare the step time against the number of launches times the cost of an empty launch
+    if (launchCounter) {
+        const auto countedLaunches = launchCounter->getLaunches();
+        launchCounter.reset();
+
+        constexpr size_t overheadSamples = 100;
+        auto launchTimer = autopas::utils::Timer();
+        for (size_t sample = 0; sample < overheadSamples; ++sample) {
+            launchTimer.start();
+            autoPasInstance.forEachKokkos<ForEachSpace::execution_space>(KOKKOS_LAMBDA(int i, const autopas::utils::KokkosStorage<ParticleType>& storage) {}, autopas::IteratorBehavior::owned);
+            Kokkos::fence();
+            launchTimer.stop();
+        }
+        std::cout << "Empty launch: " << launchTimer.getTotalTime() / overheadSamples << " ns";
+        if (not countedLaunches) {
+            std::cout << ", launches per step not counted while a Kokkos tool is loaded";
+        } else if (iterations > 0) {
+            std::cout << ", " << static_cast<double>(*countedLaunches) / static_cast<double>(iterations) << " launches per step";
+        }
+        std::cout << std::endl;
+    }
+    if (iterations > 0) {
+        std::cout << "Mean step: " << totalTimer.getTotalTime() / iterations << " ns" << std::endl;
+    }
 
+    // The fused loop prints its phases itself, only with --timeFusedStepPhases
+    if (not config.getFusedStep()) {
         std::cout << "1. Update: " << positionTimer.getTotalTime() << std::endl;
         std::cout << "2. Update: " << interactionsTimer.getTotalTime() << std::endl;
         std::cout << "3. Update: " << velocityTimer.getTotalTime() << std::endl;
+    }
+
+    if (config.getComputeEnergy()) {
+        applyWithChosenFunctor<void>(chosenFunctor, [](auto& functor) { std::cout << "Potential energy: " << functor.getPotentialEnergy() << std::endl; });
+    }
 
-        autoPasInstance.finalize();
+#ifndef KOKKOS_ENABLE_CUDA
+    if (spme) {
+        if (not config.getFusedStep()) {
+            std::cout << "2c. Long Range Update: " << longRangeTimer.getTotalTime() << std::endl;
+        }
+        spme->printTimers(std::cout);
+        std::cout << "Reciprocal energy: " << reciprocalEnergy << ", self energy: " << spme->computeSelfEnergy(autoPasInstance) << std::endl;
+    }
+#endif
+
+    if (config.getTriwise() and not config.getFusedStep() and iterations > 0) {
+        // Phases of this run only, --triwiseBaseline times the force computation with and without the triwise kernel
+        const auto pairwisePhases = positionTimer.getTotalTime() + interactionsTimer.getTotalTime() + velocityTimer.getTotalTime();
+        const auto allPhases = pairwisePhases + triwiseTimer.getTotalTime();
+        std::cout << "2b. Triwise Update: " << triwiseTimer.getTotalTime() << std::endl;
+        std::cout << "Triwise share of the step phases in this run: "
+                  << 100. * static_cast<double>(triwiseTimer.getTotalTime()) / static_cast<double>(allPhases) << " %" << std::endl;
+    }
+
+    if (config.getValidate() and iterations > 0) {
+        // Same initial state and integrator in double precision. Positions are only compared over the short horizon, as
+        // rounding differences grow exponentially in a chaotic system, the energy drift over the whole run.
+        auto options = applyWithChosenFunctor<utils::ReferenceOptions>(chosenFunctor, referenceOptions);
+        options.reciprocal = config.getSpme();
+        options.triwise = config.getTriwise();
+        options.nu = config.getNu();
+        std::vector<double> deltaT (numReplicas);
+        for (size_t r = 0; r < numReplicas; ++r) {
+            deltaT[r] = config.getDeltaT(r);
+        }
+        auto referenceState = initialState;
+        utils::Validation::integrate(referenceState, options, deltaT, trajectorySteps);
+        const double trajectoryError = trajectorySteps > 0 ? utils::Validation::comparePositions(referenceState, trajectoryState) : 0.;
+
+        const auto finalState = takeSnapshot();
+        const double drift = utils::Validation::relativeError(utils::Validation::computeTotalEnergy(initialState, options),
+                                                              utils::Validation::computeTotalEnergy(finalState, options));
+        const bool trajectoryPassed = trajectoryError <= config.getTrajectoryTolerance() and drift <= config.getDriftTolerance();
+        std::cout << "Validation trajectory: position error " << trajectoryError << " after " << trajectorySteps << " steps, energy drift "
+                  << drift << " after " << iterations << " steps" << (trajectoryPassed ? ", passed" : ", FAILED") << std::endl;
+        validationPassed = validationPassed and trajectoryPassed;
+    }
+
+    if (analysis) {
+        const auto dropped = analysis->getDroppedCounts();
+        std::cout << "Analysis: " << analysis->getNumSamples() << " samples, " << analysis->getTotalTime() << " ns ("
+                  << 100. * static_cast<double>(analysis->getTotalTime()) / static_cast<double>(totalTimer.getTotalTime()) << " % of total), "
+                  << dropped[0] << " positions and " << dropped[1] << " velocity components out of range" << std::endl;
+        analysis->write(config.getAnalysisOutput());
+    }
+
+    if (numReplicas > 1) {
+        // Per replica output, one reduction per replica as this only happens once at the end
+        for (size_t r = 0; r < numReplicas; ++r) {
+            double kineticEnergy = 0.;
+            autoPasInstance.reduceKokkos<ForEachSpace::execution_space, double, Kokkos::Sum<double>>(KOKKOS_LAMBDA(int i, const autopas::utils::KokkosStorage<ParticleType>& storage, double& local) {
+                if (storage.operator()<ParticleType::AttributeNames::replicaId, true, forEachHostFlag>(i) == r) {
+                    const double mass = storage.operator()<ParticleType::AttributeNames::mass, true, forEachHostFlag>(i);
+                    const double vX = storage.operator()<ParticleType::AttributeNames::velocityX, true, forEachHostFlag>(i);
+                    const double vY = storage.operator()<ParticleType::AttributeNames::velocityY, true, forEachHostFlag>(i);
+                    const double vZ = storage.operator()<ParticleType::AttributeNames::velocityZ, true, forEachHostFlag>(i);
+                    local += 0.5 * mass * (vX * vX + vY * vY + vZ * vZ);
+                }
+            }, kineticEnergy, autopas::IteratorBehavior::owned);
+
+            std::cout << "Replica " << r << " (seed " << config.getSeed() + r << ", deltaT " << config.getDeltaT(r)
+                      << "): kinetic energy " << kineticEnergy << std::endl;
+        }
+    }
+
+    // Owned particle steps of all replicas, --replicaBaseline measures the gain over separate single replica runs
+    const double totalSeconds = static_cast<double>(totalTimer.getTotalTime()) * 1e-9;
+    const double particleSteps = static_cast<double>(numReplicas * config.getNumParticles() * iterations);
+    std::cout << "Total: " << totalTimer.getTotalTime() << std::endl;
+    std::cout << "Aggregate throughput (" << numReplicas << " replicas): " << particleSteps / totalSeconds << " particle steps/s" << std::endl;
+
+    record.kernel = applyWithChosenFunctor<std::string>(chosenFunctor, [](auto& functor) { return functor.getVariantName(); });
+    record.numParticles = numReplicas * config.getNumParticles();
+    record.iterations = iterations;
+    record.totalTime = totalTimer.getTotalTime();
+    record.throughput = particleSteps / totalSeconds;
+    if (config.getComputeEnergy()) {
+        record.potentialEnergy = applyWithChosenFunctor<double>(chosenFunctor, [](auto& functor) { return functor.getPotentialEnergy(); });
+    }
+    if (config.getValidate()) {
+        record.validationPassed = validationPassed;
+    }
+
+    // Mean time of one fenced call of compute after a warm up, e.g. first touch and kernel loading
+    const auto timeForces = [](size_t repetitions, auto compute) {
+        compute();
+        Kokkos::fence();
+
+        auto timer = autopas::utils::Timer();
+        for (size_t r = 0; r < repetitions; ++r) {
+            timer.start();
+            compute();
+            Kokkos::fence();
+            timer.stop();
+        }
+        return static_cast<double>(timer.getTotalTime()) / static_cast<double>(repetitions);
+    };
+
+    if (config.getTriwiseBaselineRepetitions() > 0) {
+        // Both on the final particle state of this run, independent of --fusedStep
+        const size_t repetitions = config.getTriwiseBaselineRepetitions();
+        const auto [pairwiseTime, bothTime] = applyWithChosenFunctor<std::pair<double, double>>(chosenFunctor, [&](auto& functor) {
+            const double pairwise = timeForces(repetitions, [&]() { autoPasInstance.computeInteractions(&functor); });
+            const double both = timeForces(repetitions, [&]() {
+                autoPasInstance.computeInteractions(&functor);
+                applyWithChosenTriwiseFunctor<bool>([&](auto && triwiseFunctor) { return autoPasInstance.computeInteractions(&triwiseFunctor); }, config);
+            });
+            return std::pair{pairwise, both};
+        });
+        std::cout << "Triwise baseline: " << pairwiseTime << " ns per pairwise force computation, " << bothTime
+                  << " ns with the triwise kernel, ratio " << bothTime / pairwiseTime << std::endl;
+        record.triwiseCost = bothTime / pairwiseTime;
+    }
+
+    if (numReplicas > 1 and config.getReplicaBaselineRepetitions() > 0) {
+        // Same force computation on a separate instance holding only replica 0. The ensemble gains if one computation
+        // of all replicas takes less than numReplicas computations of a single one.
+        const auto baselineConfig = config.withSingleReplica();
+        autopas::AutoPas<ParticleType> baselineInstance (std::cout);
+        utils::Setup::provideOptions(baselineInstance, baselineConfig);
+        baselineInstance.init();
+        baselineInstance.reserve(baselineConfig.getNumParticles(), baselineConfig.getNumHalos());
+        utils::Setup::fillParticles(baselineInstance, baselineConfig);
+
+        const size_t repetitions = config.getReplicaBaselineRepetitions();
+        const auto [ensembleTime, singleTime] = applyWithChosenFunctor<std::pair<double, double>>(chosenFunctor, [&](auto& functor) {
+            return std::pair{timeForces(repetitions, [&]() { autoPasInstance.computeInteractions(&functor); }),
+                             timeForces(repetitions, [&]() { baselineInstance.computeInteractions(&functor); })};
+        });
+        const double speedup = static_cast<double>(numReplicas) * singleTime / ensembleTime;
+        std::cout << "Replica baseline: " << ensembleTime << " ns per force computation of " << numReplicas << " replicas, "
+                  << singleTime << " ns of one replica, speedup over separate runs " << speedup << std::endl;
+        record.replicaSpeedup = speedup;
+
+        baselineInstance.finalize();
+    }
+
+    return validationPassed;
+}
+
+int main(int argc, char** argv) {
+
+    autopas::AutoPas_MPI_Init(&argc, &argv);
+    autopas::AutoPas_Kokkos_Init(argc, argv);
+    int exitCode = 0;
+    {
+        const std::vector<std::string> commandLine (argv + 1, argv + argc);
+        Configuration commandLineConfig {};
+        bool batch = false;
+        std::vector<std::vector<std::string>> runs {};
+        try {
+            commandLineConfig.parseArguments(commandLine);
+
+            // Without --batch the command line is the only run, otherwise every batch line is appended to it
+            batch = not commandLineConfig.getBatchFile().empty();
+            runs = batch ? Configuration::readBatchFile(commandLineConfig.getBatchFile()) : std::vector<std::vector<std::string>>{{}};
+        } catch (const std::exception& e) {
+            std::cerr << "Invalid command line: " << e.what() << std::endl;
+            exitCode = 1;
+        }
+        std::ofstream records;
+        if (batch) {
+            records.open(commandLineConfig.getBatchOutput());
+        }
+
+        // Kokkos stays initialized for all runs, the AutoPas instance as long as the options match. Every run reserves
+        // its own particle count on the instance, so a reused instance grows with the largest run.
+        std::unique_ptr<autopas::AutoPas<ParticleType>> autoPasInstance {};
+        Configuration instanceConfig {};
+
+        for (size_t run = 0; run < runs.size(); ++run) {
+            auto arguments = commandLine;
+            arguments.insert(arguments.end(), runs[run].begin(), runs[run].end());
+
+            utils::RunRecord record {};
+            record.run = run;
+            record.arguments = runs[run];
+
+            // A failing run is recorded and skipped, the remaining runs and the finalization still happen
+            try {
+                Configuration config {};
+                config.parseArguments(arguments);
+
+                const bool reuseInstance = autoPasInstance and instanceConfig.isInstanceCompatible(config);
+                if (not reuseInstance) {
+                    if (autoPasInstance) {
+                        autoPasInstance->finalize();
+                    }
+                    autoPasInstance = std::make_unique<autopas::AutoPas<ParticleType>>(std::cout);
+                    instanceConfig = config;
+                }
+                record.reusedInstance = reuseInstance;
+
+                if (not runSimulation(config, *autoPasInstance, reuseInstance, record)) {
+                    exitCode = 1;
+                }
+            } catch (const std::exception& e) {
+                std::cerr << "Run " << run << " failed: " << e.what() << std::endl;
+                record.error = e.what();
+                exitCode = 1;
+                // The instance may be half initialized or hold particles of the failed run, the next run starts fresh.
+                // Finalized first like every other instance, a second failure there must not end the batch.
+                if (autoPasInstance) {
+                    try {
+                        autoPasInstance->finalize();
+                    } catch (const std::exception& finalizeError) {
+                        std::cerr << "Run " << run << ": finalize after the failure failed as well: " << finalizeError.what() << std::endl;
+                    }
+                }
+                autoPasInstance.reset();
+            }
+
+            if (batch) {
+                records << record.toJson() << std::endl;
+            }
+        }
+
+        if (autoPasInstance) {
+            autoPasInstance->finalize();
+        }
     }
     autopas::AutoPas_MPI_Finalize();
     autopas::AutoPas_Kokkos_Finalize();
 
-    return 0;
-}
\ No newline at end of file
+    return exitCode;
+}
@@ -9,4 +9,4 @@
 #include "autopas/AutoPasImpl.h"
 #include "utils/KokkosParticle.h"
 
-template class autopas::AutoPas<KokkosParticle>;
\ No newline at end of file
+template class autopas::AutoPas<ParticleType>;
\ No newline at end of file
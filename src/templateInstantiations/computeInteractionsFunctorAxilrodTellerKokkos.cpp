@@ -0,0 +1,15 @@
+/**
+ * @file computeInteractionsFunctorAxilrodTellerKokkos.cpp
+ * @date 19.10.2026
+ * @author Luis Gall
+ */
+
+#include <autopas/AutoPasImpl.h>
+#include <utils/KokkosParticle.h>
+#include <utils/FunctorAxilrodTellerKokkos.h>
+
+#ifdef KOKKOS_ENABLE_CUDA
+template bool autopas::AutoPas<ParticleType>::computeInteractions(FunctorAxilrodTellerKokkos<ParticleType, Kokkos::CudaSpace> *);
+#else
+template bool autopas::AutoPas<ParticleType>::computeInteractions(FunctorAxilrodTellerKokkos<ParticleType, Kokkos::HostSpace> *);
+#endif
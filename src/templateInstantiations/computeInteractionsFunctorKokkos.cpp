@@ -7,9 +7,22 @@
 #include <autopas/AutoPasImpl.h>
 #include <utils/KokkosParticle.h>
 #include <utils/FunctorKokkos.h>
+#include <utils/FunctorKokkosGeneric.h>
+#include <utils/KernelVariants.h>
 
 #ifdef KOKKOS_ENABLE_CUDA
-template bool autopas::AutoPas<KokkosParticle>::computeInteractions(FunctorKokkos<KokkosParticle, Kokkos::CudaSpace> *);
+#define AUTOPASSIMULATOR_INSTANTIATE_KERNEL_VARIANT(newton3, energy, multiType, periodic, coulomb) \
+    template bool autopas::AutoPas<ParticleType>::computeInteractions(FunctorKokkos<ParticleType, Kokkos::CudaSpace, newton3, energy, multiType, periodic, coulomb> *);
 #else
-template bool autopas::AutoPas<KokkosParticle>::computeInteractions(FunctorKokkos<KokkosParticle, Kokkos::HostSpace> *);
+#define AUTOPASSIMULATOR_INSTANTIATE_KERNEL_VARIANT(newton3, energy, multiType, periodic, coulomb) \
+    template bool autopas::AutoPas<ParticleType>::computeInteractions(FunctorKokkos<ParticleType, Kokkos::HostSpace, newton3, energy, multiType, periodic, coulomb> *);
+#endif
+
+AUTOPASSIMULATOR_FOR_EACH_KERNEL_VARIANT(AUTOPASSIMULATOR_INSTANTIATE_KERNEL_VARIANT)
+
+// Baseline of --benchmarkKernels, outside of the variant budget
+#ifdef KOKKOS_ENABLE_CUDA
+template bool autopas::AutoPas<ParticleType>::computeInteractions(FunctorKokkosGeneric<ParticleType, Kokkos::CudaSpace> *);
+#else
+template bool autopas::AutoPas<ParticleType>::computeInteractions(FunctorKokkosGeneric<ParticleType, Kokkos::HostSpace> *);
 #endif
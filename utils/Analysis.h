@@ -0,0 +1,262 @@
+/**
+ * @file Analysis.h
+ * @date 19.10.2026
+ * @author Luis Gall
+ */
+
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <fstream>
+#include <numbers>
+#include <string>
+#include <type_traits>
+
+#include <Kokkos_ScatterView.hpp>
+
+#include "autopas/utils/Timer.h"
+
+#include "Configuration.h"
+#include "FunctorRDFKokkos.h"
+#include "KokkosParticle.h"
+
+namespace utils {
+
+    /**
+     * In-situ analysis on the execution space: radial distribution function, number density grid and velocity
+     * distributions. All three are accumulated in the memory space of the kernels over all samples, only the
+     * histograms are copied to the host once in write().
+     */
+    template <class MemSpace>
+    class InSituAnalysis {
+    public:
+        using ExecutionSpace = typename MemSpace::execution_space;
+
+        using DensityGrid = Kokkos::View<double***, Kokkos::LayoutRight, MemSpace>;
+
+        using ScatterDensityGrid = Kokkos::Experimental::ScatterView<double***, Kokkos::LayoutRight, ExecutionSpace>;
+
+        // One row per velocity component
+        using VelocityHistogram = Kokkos::View<double**, Kokkos::LayoutRight, MemSpace>;
+
+        using ScatterVelocityHistogram = Kokkos::Experimental::ScatterView<double**, Kokkos::LayoutRight, ExecutionSpace>;
+
+        // Samples outside the histogram ranges: positions outside the box, velocity components outside the velocity range
+        using DroppedCounts = Kokkos::View<size_t[2], MemSpace>;
+
+        explicit InSituAnalysis(const Configuration& config)
+            : _rdf(config.getCutoff(), config.getAnalysisBins(), config.getPeriodic() ? config.getBoxMax() - config.getBoxMin() : 0.),
+            _densityGrid("densityGrid", config.getAnalysisGridSize(), config.getAnalysisGridSize(), config.getAnalysisGridSize()),
+            _scatterDensityGrid(_densityGrid),
+            _velocityHistogram("velocityHistogram", 3, config.getAnalysisBins()),
+            _scatterVelocityHistogram(_velocityHistogram),
+            _droppedCounts("analysisDroppedCounts"),
+            _cutoff{config.getCutoff()},
+            _boxMin{config.getBoxMin()},
+            _boxLength{config.getBoxMax() - config.getBoxMin()},
+            _maxVelocity{config.getAnalysisMaxVelocity()},
+            _numReplicas{config.getNumReplicas()},
+            _numParticles{config.getNumReplicas() * config.getNumParticles()}
+        {}
+
+        /**
+         * Adds the current state of all owned particles to the histograms.
+         */
+        template <class Container>
+        void sample(Container& autopasInstance) {
+            _timer.start();
+            Kokkos::Profiling::pushRegion("Analysis");
+
+            // The histograms accumulate over all samples, only the duplicates of the ScatterViews start from zero
+            _rdf.prepare();
+            _scatterDensityGrid.reset_except(_densityGrid);
+            _scatterVelocityHistogram.reset_except(_velocityHistogram);
+
+            autopasInstance.computeInteractions(&_rdf);
+            _rdf.contribute();
+
+            constexpr bool forEachHost = std::is_same_v<MemSpace, Kokkos::HostSpace>;
+            const size_t gridSize = _densityGrid.extent(0);
+            const size_t numVelocityBins = _velocityHistogram.extent(1);
+            const double boxMin = _boxMin;
+            const double cellsPerLength = static_cast<double>(gridSize) / _boxLength;
+            const double maxVelocity = _maxVelocity;
+            const double velocityBinsPerSpeed = static_cast<double>(numVelocityBins) / (2. * maxVelocity);
+            auto scatterDensityGrid = _scatterDensityGrid;
+            auto scatterVelocityHistogram = _scatterVelocityHistogram;
+            const DroppedCounts droppedCounts = _droppedCounts;
+
+            autopasInstance.template forEachKokkos<ExecutionSpace>(KOKKOS_LAMBDA(int i, const autopas::utils::KokkosStorage<ParticleType>& storage) {
+                // Out of range samples are counted instead of being piled up in the edge bins
+                const auto inRange = [](double index, size_t numBins) {
+                    return index >= 0. and index < static_cast<double>(numBins);
+                };
+
+                const double cellX = Kokkos::floor((storage.template operator()<ParticleType::AttributeNames::posX, true, forEachHost>(i) - boxMin) * cellsPerLength);
+                const double cellY = Kokkos::floor((storage.template operator()<ParticleType::AttributeNames::posY, true, forEachHost>(i) - boxMin) * cellsPerLength);
+                const double cellZ = Kokkos::floor((storage.template operator()<ParticleType::AttributeNames::posZ, true, forEachHost>(i) - boxMin) * cellsPerLength);
+                if (inRange(cellX, gridSize) and inRange(cellY, gridSize) and inRange(cellZ, gridSize)) {
+                    auto densityAccess = scatterDensityGrid.access();
+                    densityAccess(static_cast<size_t>(cellX), static_cast<size_t>(cellY), static_cast<size_t>(cellZ)) += 1.;
+                } else {
+                    Kokkos::atomic_inc(&droppedCounts(0));
+                }
+
+                const double velocities[3] = {storage.template operator()<ParticleType::AttributeNames::velocityX, true, forEachHost>(i),
+                                              storage.template operator()<ParticleType::AttributeNames::velocityY, true, forEachHost>(i),
+                                              storage.template operator()<ParticleType::AttributeNames::velocityZ, true, forEachHost>(i)};
+                auto velocityAccess = scatterVelocityHistogram.access();
+                for (size_t d = 0; d < 3; ++d) {
+                    const double bin = Kokkos::floor((velocities[d] + maxVelocity) * velocityBinsPerSpeed);
+                    if (inRange(bin, numVelocityBins)) {
+                        velocityAccess(d, static_cast<size_t>(bin)) += 1.;
+                    } else {
+                        Kokkos::atomic_inc(&droppedCounts(1));
+                    }
+                }
+            }, autopas::IteratorBehavior::owned);
+
+            Kokkos::Experimental::contribute(_densityGrid, _scatterDensityGrid);
+            Kokkos::Experimental::contribute(_velocityHistogram, _scatterVelocityHistogram);
+
+            Kokkos::fence();
+            Kokkos::Profiling::popRegion();
+            _timer.stop();
+            ++_numSamples;
+        }
+
+        /**
+         * Copies the histograms to the host and writes the normalized averages to <prefix>_rdf.csv,
+         * <prefix>_density.csv and <prefix>_velocity.csv.
+         */
+        void write(const std::string& prefix) const {
+            if (_numSamples == 0 or _numParticles == 0) {
+                return;
+            }
+
+            const auto rdfHost = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), _rdf.getHistogram());
+            const auto densityHost = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), _densityGrid);
+            const auto velocityHost = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), _velocityHistogram);
+            const auto droppedHost = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), _droppedCounts);
+
+            const double samples = static_cast<double>(_numSamples);
+            const double numParticles = static_cast<double>(_numParticles);
+            const double numReplicas = static_cast<double>(_numReplicas);
+
+            // g(r) = counts / (samples * N * rho * shell volume), rho of a single replica as pairs never cross replicas
+            {
+                std::ofstream out (prefix + "_rdf.csv");
+                out << "r,g" << std::endl;
+                const size_t numBins = rdfHost.extent(0);
+                const double binWidth = _cutoff / static_cast<double>(numBins);
+                const double density = numParticles / (numReplicas * _boxLength * _boxLength * _boxLength);
+                for (size_t bin = 0; bin < numBins; ++bin) {
+                    const double rInner = bin * binWidth;
+                    const double rOuter = rInner + binWidth;
+                    const double shellVolume = 4. / 3. * std::numbers::pi * (rOuter * rOuter * rOuter - rInner * rInner * rInner);
+                    out << rInner + binWidth / 2. << "," << rdfHost(bin) / (samples * numParticles * density * shellVolume) << std::endl;
+                }
+            }
+
+            {
+                std::ofstream out (prefix + "_density.csv");
+                out << "# " << droppedHost(0) << " particle samples outside the box dropped" << std::endl;
+                out << "x,y,z,density" << std::endl;
+                const size_t gridSize = densityHost.extent(0);
+                const double cellLength = _boxLength / static_cast<double>(gridSize);
+                const double cellVolume = cellLength * cellLength * cellLength;
+                for (size_t a = 0; a < gridSize; ++a) {
+                    for (size_t b = 0; b < gridSize; ++b) {
+                        for (size_t c = 0; c < gridSize; ++c) {
+                            out << _boxMin + (a + 0.5) * cellLength << "," << _boxMin + (b + 0.5) * cellLength << "," << _boxMin + (c + 0.5) * cellLength
+                                << "," << densityHost(a, b, c) / (samples * numReplicas * cellVolume) << std::endl;
+                        }
+                    }
+                }
+            }
+
+            {
+                std::ofstream out (prefix + "_velocity.csv");
+                out << "# " << droppedHost(1) << " velocity components outside [" << -_maxVelocity << ", " << _maxVelocity << "] dropped" << std::endl;
+                out << "v,px,py,pz" << std::endl;
+                const size_t numBins = velocityHost.extent(1);
+                const double binWidth = 2. * _maxVelocity / static_cast<double>(numBins);
+                const double normalization = samples * numParticles * binWidth;
+                for (size_t bin = 0; bin < numBins; ++bin) {
+                    out << -_maxVelocity + (bin + 0.5) * binWidth << "," << velocityHost(0, bin) / normalization << ","
+                        << velocityHost(1, bin) / normalization << "," << velocityHost(2, bin) / normalization << std::endl;
+                }
+            }
+        }
+
+        /**
+         * Sums of the RDF, density and velocity histograms over all samples, copied to the host.
+         */
+        std::array<double, 3> getTotalCounts() const {
+            const auto rdfHost = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), _rdf.getHistogram());
+            const auto densityHost = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), _densityGrid);
+            const auto velocityHost = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), _velocityHistogram);
+
+            std::array<double, 3> counts {0., 0., 0.};
+            for (size_t bin = 0; bin < rdfHost.extent(0); ++bin) {
+                counts[0] += rdfHost(bin);
+            }
+            for (size_t cell = 0; cell < densityHost.size(); ++cell) {
+                counts[1] += densityHost.data()[cell];
+            }
+            for (size_t bin = 0; bin < velocityHost.size(); ++bin) {
+                counts[2] += velocityHost.data()[bin];
+            }
+            return counts;
+        }
+
+        /**
+         * Samples dropped so far: particles outside the box and velocity components outside the velocity range.
+         */
+        std::array<size_t, 2> getDroppedCounts() const {
+            const auto droppedHost = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), _droppedCounts);
+            return {droppedHost(0), droppedHost(1)};
+        }
+
+        auto getNumSamples() const {
+            return _numSamples;
+        }
+
+        auto getTotalTime() const {
+            return _timer.getTotalTime();
+        }
+
+    private:
+
+        FunctorRDFKokkos<ParticleType, MemSpace> _rdf;
+
+        DensityGrid _densityGrid;
+
+        ScatterDensityGrid _scatterDensityGrid;
+
+        VelocityHistogram _velocityHistogram;
+
+        ScatterVelocityHistogram _scatterVelocityHistogram;
+
+        DroppedCounts _droppedCounts;
+
+        double _cutoff;
+
+        double _boxMin;
+
+        double _boxLength;
+
+        double _maxVelocity;
+
+        size_t _numReplicas;
+
+        // Owned particles of all replicas
+        size_t _numParticles;
+
+        size_t _numSamples {0};
+
+        autopas::utils::Timer _timer {};
+    };
+
+}
@@ -6,52 +6,224 @@
 
 #pragma once
 
+#include <fstream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 class Configuration {
 
 public:
 
     void parseConfig(int argc, char** argv) {
+        parseArguments(std::vector<std::string>(argv + 1, argv + argc));
+    }
+
+    /**
+     * Same as parseConfig() for an argument list without the program name. Later occurrences of a key win,
+     * --config <file> reads further keys from a file, see readConfigFile().
+     */
+    void parseArguments(const std::vector<std::string>& arguments) {
+
+        // Extracting the values of the map
+        for (auto& pair : parseOptions(arguments)) {
+            if (pair.first == "--cutoff") {
+                _cutoff = std::stod(pair.second);
+            } else if (pair.first == "--iterations") {
+                _numIterations = parseSize(pair.second);
+            } else if (pair.first == "--deltaT") {
+                _deltaT = std::stod(pair.second);
+            } else if (pair.first == "--boxMin") {
+                _boxMin = std::stod(pair.second);
+            } else if (pair.first == "--boxMax") {
+                _boxMax = std::stod(pair.second);
+            } else if (pair.first == "--numParticles") {
+                _numParticles = parseSize(pair.second);
+            } else if (pair.first == "--numHalos") {
+                _numHalos = parseSize(pair.second);
+            } else if (pair.first == "--triwise") {
+                _triwise = true;
+            } else if (pair.first == "--nu") {
+                _nu = std::stod(pair.second);
+            } else if (pair.first == "--triwiseBaseline") {
+                _triwiseBaselineRepetitions = parseSize(pair.second);
+            } else if (pair.first == "--replicas") {
+                _numReplicas = parseSize(pair.second);
+            } else if (pair.first == "--seed") {
+                _seed = std::stoul(pair.second);
+            } else if (pair.first == "--replicaDeltaT") {
+                // Comma separated list with one time step width per replica
+                _replicaDeltaT = parseList(pair.second);
+            } else if (pair.first == "--replicaBaseline") {
+                _replicaBaselineRepetitions = parseSize(pair.second);
+            } else if (pair.first == "--newton3") {
+                _newton3 = parseBool(pair.second);
+            } else if (pair.first == "--computeEnergy") {
+                _computeEnergy = true;
+            } else if (pair.first == "--periodic") {
+                _periodic = true;
+            } else if (pair.first == "--epsilons") {
+                _epsilons = parseList(pair.second);
+            } else if (pair.first == "--sigmas") {
+                _sigmas = parseList(pair.second);
+            } else if (pair.first == "--spme") {
+                _spme = true;
+            } else if (pair.first == "--spmeGrid") {
+                _spmeGridSize = parseSize(pair.second);
+            } else if (pair.first == "--spmeOrder") {
+                _spmeSplineOrder = parseSize(pair.second);
+            } else if (pair.first == "--ewaldAlpha") {
+                _ewaldAlpha = std::stod(pair.second);
+            } else if (pair.first == "--charge") {
+                _charge = std::stod(pair.second);
+            } else if (pair.first == "--fusedStep") {
+                _fusedStep = true;
+            } else if (pair.first == "--timeFusedStepPhases") {
+                _timeFusedStepPhases = true;
+            } else if (pair.first == "--countLaunches") {
+                _countLaunches = true;
+            } else if (pair.first == "--analysisInterval") {
+                _analysisInterval = parseSize(pair.second);
+            } else if (pair.first == "--analysisBins") {
+                _analysisBins = parseSize(pair.second);
+            } else if (pair.first == "--analysisGrid") {
+                _analysisGridSize = parseSize(pair.second);
+            } else if (pair.first == "--analysisMaxVelocity") {
+                _analysisMaxVelocity = std::stod(pair.second);
+            } else if (pair.first == "--analysisOutput") {
+                _analysisOutput = pair.second;
+            } else if (pair.first == "--validate") {
+                _validate = true;
+            } else if (pair.first == "--forceTolerance") {
+                _forceTolerance = std::stod(pair.second);
+            } else if (pair.first == "--energyTolerance") {
+                _energyTolerance = std::stod(pair.second);
+            } else if (pair.first == "--trajectoryTolerance") {
+                _trajectoryTolerance = std::stod(pair.second);
+            } else if (pair.first == "--trajectorySteps") {
+                _trajectorySteps = parseSize(pair.second);
+            } else if (pair.first == "--spmeTolerance") {
+                _spmeTolerance = std::stod(pair.second);
+            } else if (pair.first == "--driftTolerance") {
+                _driftTolerance = std::stod(pair.second);
+            } else if (pair.first == "--batch") {
+                _batchFile = pair.second;
+            } else if (pair.first == "--batchOutput") {
+                _batchOutput = pair.second;
+            } else if (pair.first == "--benchmarkKernels") {
+                _benchmarkKernelRepetitions = parseSize(pair.second);
+            }
+        }
+
+        if (_epsilons.empty() or _epsilons.size() != _sigmas.size()) {
+            throw std::invalid_argument("Configuration: --epsilons and --sigmas need one entry per type, at least one type");
+        }
+
+        // The minimum image divides by the box length
+        if (_periodic and _boxMax <= _boxMin) {
+            throw std::invalid_argument("Configuration: --periodic requires --boxMax greater than --boxMin");
+        }
+
+        if (_analysisInterval > 0 and (_analysisBins == 0 or _analysisGridSize == 0 or _analysisMaxVelocity <= 0.)) {
+            throw std::invalid_argument("Configuration: --analysisBins, --analysisGrid and --analysisMaxVelocity must be positive");
+        }
+
+        if (_triwiseBaselineRepetitions > 0 and not _triwise) {
+            throw std::invalid_argument("Configuration: --triwiseBaseline requires --triwise");
+        }
+
+        if (_spme and not _periodic) {
+            throw std::invalid_argument("Configuration: --spme requires --periodic");
+        }
+
+        if (_spme and _numReplicas > 1) {
+            throw std::invalid_argument("Configuration: --spme does not support --replicas");
+        }
+
+        // The Ewald sum of a charged periodic system diverges, and there is no background correction
+        if (_spme and _numParticles % 2 != 0) {
+            throw std::invalid_argument("Configuration: --spme needs an even --numParticles, the alternating charges are only neutral then");
+        }
+    }
+
+    /**
+     * Map of [--option : value] entries. An option takes the next argument as value unless that starts with '-', so
+     * flags need no value. Later occurrences of a key win, --config <file> is expanded in place.
+     */
+    static std::map<std::string, std::string> parseOptions(const std::vector<std::string>& arguments) {
 
         std::map<std::string, std::string> options;
 
-        // Creating a map of [--option : value] entries
-        for (int i = 1; i < argc; ++i) {
-            std::string arg = argv[i];
+        for (size_t i = 0; i < arguments.size(); ++i) {
+            const std::string& arg = arguments[i];
             if (!arg.empty() && arg[0] == '-') {
                 std::string key = arg;
                 std::string value;
 
-                if (i+1 < argc) {
-                    std::string potentialValue = argv[i+1];
+                if (i+1 < arguments.size()) {
+                    const std::string& potentialValue = arguments[i+1];
                     if (!potentialValue.empty() && potentialValue[0] != '-') {
                         value = potentialValue;
                         ++i;
                     }
                 }
-                options[key] = value;
+
+                if (key == "--config") {
+                    readConfigFile(value, options);
+                } else {
+                    options[key] = value;
+                }
             }
         }
+        return options;
+    }
 
-        // Extracting the values of the map
-        for (auto& pair : options) {
-            if (pair.first == "--cutoff") {
-                _cutoff = std::stod(pair.second);
-            } else if (pair.first == "--iterations") {
-                _numIterations = std::stoi(pair.second);
-            } else if (pair.first == "--deltaT") {
-                _deltaT = std::stod(pair.second);
-            } else if (pair.first == "--boxMin") {
-                _boxMin = std::stod(pair.second);
-            } else if (pair.first == "--boxMax") {
-                _boxMax = std::stod(pair.second);
-            } else if (pair.first == "--numParticles") {
-                _numParticles = std::stoi(pair.second);
-            } else if (pair.first == "--numHalos") {
-                _numHalos = std::stoi(pair.second);
+    /**
+     * Comma separated list of numbers, e.g. "1,1.2".
+     */
+    static std::vector<double> parseList(const std::string& value) {
+        std::vector<double> list;
+        std::stringstream stream(value);
+        for (std::string entry; std::getline(stream, entry, ',');) {
+            list.push_back(std::stod(entry));
+        }
+        return list;
+    }
+
+    /**
+     * Arguments of every run in a batch file, one run per line, e.g. "--numParticles 1000 --cutoff 2.5".
+     * Empty lines and lines starting with # are skipped.
+     */
+    static std::vector<std::vector<std::string>> readBatchFile(const std::string& path) {
+        std::ifstream file (path);
+        if (not file) {
+            throw std::invalid_argument("Configuration: cannot open batch file " + path);
+        }
+
+        std::vector<std::vector<std::string>> runs;
+        for (std::string line; std::getline(file, line);) {
+            std::stringstream stream (line);
+            std::vector<std::string> arguments;
+            for (std::string token; stream >> token;) {
+                arguments.push_back(token);
+            }
+            if (not arguments.empty() and arguments.front()[0] != '#') {
+                runs.push_back(arguments);
             }
         }
+        return runs;
+    }
+
+    /**
+     * Whether an AutoPas instance set up for this configuration can be reused for other, i.e. all options passed to
+     * Setup::provideOptions() match.
+     */
+    bool isInstanceCompatible(const Configuration& other) const {
+        return _boxMin == other._boxMin and _boxMax == other._boxMax and _cutoff == other._cutoff
+            and _newton3 == other._newton3 and _triwise == other._triwise;
     }
 
     auto getCutoff() const {
@@ -82,7 +254,203 @@ public:
         return _numIterations;
     }
 
+    auto getNumReplicas() const {
+        return _numReplicas;
+    }
+
+    auto getSeed() const {
+        return _seed;
+    }
+
+    auto getReplicaBaselineRepetitions() const {
+        return _replicaBaselineRepetitions;
+    }
+
+    /**
+     * Same configuration with only the first replica, for the single replica baseline of the ensemble.
+     */
+    Configuration withSingleReplica() const {
+        Configuration single = *this;
+        single._numReplicas = 1;
+        if (not single._replicaDeltaT.empty()) {
+            single._replicaDeltaT.resize(1);
+        }
+        return single;
+    }
+
+    /**
+     * Time step width of the given replica. Falls back to --deltaT for replicas without an explicit value.
+     */
+    double getDeltaT(size_t replica) const {
+        return replica < _replicaDeltaT.size() ? _replicaDeltaT[replica] : _deltaT;
+    }
+
+    auto getNewton3() const {
+        return _newton3;
+    }
+
+    auto getComputeEnergy() const {
+        return _computeEnergy;
+    }
+
+    auto getPeriodic() const {
+        return _periodic;
+    }
+
+    size_t getNumTypes() const {
+        return _epsilons.size();
+    }
+
+    const auto& getEpsilons() const {
+        return _epsilons;
+    }
+
+    const auto& getSigmas() const {
+        return _sigmas;
+    }
+
+    auto getSpme() const {
+        return _spme;
+    }
+
+    auto getSpmeGridSize() const {
+        return _spmeGridSize;
+    }
+
+    auto getSpmeSplineOrder() const {
+        return _spmeSplineOrder;
+    }
+
+    auto getEwaldAlpha() const {
+        return _ewaldAlpha;
+    }
+
+    auto getCharge() const {
+        return _charge;
+    }
+
+    auto getFusedStep() const {
+        return _fusedStep;
+    }
+
+    auto getTimeFusedStepPhases() const {
+        return _timeFusedStepPhases;
+    }
+
+    auto getCountLaunches() const {
+        return _countLaunches;
+    }
+
+    auto getAnalysisInterval() const {
+        return _analysisInterval;
+    }
+
+    auto getAnalysisBins() const {
+        return _analysisBins;
+    }
+
+    auto getAnalysisGridSize() const {
+        return _analysisGridSize;
+    }
+
+    auto getAnalysisMaxVelocity() const {
+        return _analysisMaxVelocity;
+    }
+
+    const auto& getAnalysisOutput() const {
+        return _analysisOutput;
+    }
+
+    auto getValidate() const {
+        return _validate;
+    }
+
+    auto getForceTolerance() const {
+        return _forceTolerance;
+    }
+
+    auto getEnergyTolerance() const {
+        return _energyTolerance;
+    }
+
+    auto getTrajectoryTolerance() const {
+        return _trajectoryTolerance;
+    }
+
+    auto getTrajectorySteps() const {
+        return _trajectorySteps;
+    }
+
+    auto getDriftTolerance() const {
+        return _driftTolerance;
+    }
+
+    auto getSpmeTolerance() const {
+        return _spmeTolerance;
+    }
+
+    const auto& getBatchFile() const {
+        return _batchFile;
+    }
+
+    const auto& getBatchOutput() const {
+        return _batchOutput;
+    }
+
+    auto getBenchmarkKernelRepetitions() const {
+        return _benchmarkKernelRepetitions;
+    }
+
+    auto getTriwise() const {
+        return _triwise;
+    }
+
+    auto getNu() const {
+        return _nu;
+    }
+
+    auto getTriwiseBaselineRepetitions() const {
+        return _triwiseBaselineRepetitions;
+    }
+
 private:
+
+    /**
+     * Adds the "key value" lines of a configuration file, the keys are the command line options with or without the
+     * leading --. Flags have no value. Keys already given on the command line are not overwritten.
+     */
+    static void readConfigFile(const std::string& path, std::map<std::string, std::string>& options) {
+        std::ifstream file (path);
+        if (not file) {
+            throw std::invalid_argument("Configuration: cannot open config file " + path);
+        }
+
+        for (std::string line; std::getline(file, line);) {
+            std::stringstream stream (line);
+            std::string key;
+            std::string value;
+            if (not (stream >> key) or key[0] == '#') {
+                continue;
+            }
+            stream >> value;
+            options.emplace(key.starts_with("--") ? key : "--" + key, value);
+        }
+    }
+
+    /**
+     * Counts and sizes: std::stoul without the silent wrap around of a negative value.
+     */
+    static size_t parseSize(const std::string& value) {
+        if (value.find('-') != std::string::npos) {
+            throw std::invalid_argument("Configuration: expected a non-negative integer, got " + value);
+        }
+        return std::stoul(value);
+    }
+
+    static bool parseBool(const std::string& value) {
+        return value.empty() or value == "1" or value == "true" or value == "enabled";
+    }
+
     double _cutoff {0.1};
 
     double _boxMin {0};
@@ -96,4 +464,103 @@ private:
     size_t _numHalos {0};
 
     double _deltaT {0};
+
+    // Number of independent systems simulated side by side, each with numParticles and numHalos particles
+    size_t _numReplicas {1};
+
+    // Replica r uses _seed + r
+    unsigned long _seed {std::default_random_engine::default_seed};
+
+    std::vector<double> _replicaDeltaT {};
+
+    // Force computations timed on the ensemble and on a single replica instance, 0 disables the baseline
+    size_t _replicaBaselineRepetitions {0};
+
+    bool _newton3 {true};
+
+    bool _computeEnergy {false};
+
+    // Minimum image convention in the cubic box [boxMin, boxMax]
+    bool _periodic {false};
+
+    // One entry per particle type, more than one type selects the MultiType kernels
+    std::vector<double> _epsilons {1.};
+
+    std::vector<double> _sigmas {1.};
+
+    // Ewald sum: real-space part in FunctorKokkos, reciprocal part with SPME
+    bool _spme {false};
+
+    // Grid points per dimension, power of two
+    size_t _spmeGridSize {32};
+
+    size_t _spmeSplineOrder {4};
+
+    double _ewaldAlpha {1.};
+
+    // Owned particles get +charge and -charge alternating, --spme requires an even particle count so the system is neutral
+    double _charge {1.};
+
+    // Step loop with the half kick and the next drift fused into one launch, instead of the separate update phases
+    bool _fusedStep {false};
+
+    // Fences after every phase of the fused loop to time them separately
+    bool _timeFusedStepPhases {false};
+
+    // Counts the kernel launches per step through the Kokkos Tools callbacks
+    bool _countLaunches {false};
+
+    // Every this many steps the in-situ analysis samples the system, 0 disables it
+    size_t _analysisInterval {0};
+
+    // Bins of the radial distribution function and of each velocity component
+    size_t _analysisBins {100};
+
+    // Cells per dimension of the density grid
+    size_t _analysisGridSize {16};
+
+    // Velocity histograms cover [-analysisMaxVelocity, analysisMaxVelocity]
+    double _analysisMaxVelocity {5.};
+
+    // Prefix of the written csv files
+    std::string _analysisOutput {"analysis"};
+
+    // Compares the chosen kernel and the trajectory against the double-precision reference in Validation.h
+    bool _validate {false};
+
+    // Largest force deviation of a particle, relative to the RMS reference force
+    double _forceTolerance {1e-3};
+
+    // Relative deviation of the potential energy
+    double _energyTolerance {1e-3};
+
+    // Largest absolute position deviation after trajectorySteps steps
+    double _trajectoryTolerance {1e-3};
+
+    // Horizon of the position comparison. Trajectories diverge exponentially, so only the first steps are comparable
+    // between single and double precision, the drift check covers all iterations.
+    size_t _trajectorySteps {10};
+
+    // Relative change of the total energy between the first and the last step
+    double _driftTolerance {1e-2};
+
+    // Relative deviation of the SPME forces (relative to the RMS reference force) and energy from the direct Ewald sum
+    double _spmeTolerance {1e-3};
+
+    // One run per line, see readBatchFile()
+    std::string _batchFile {};
+
+    // JSON lines with one record per batch run
+    std::string _batchOutput {"batch.jsonl"};
+
+    // If > 0 every compiled kernel variant is timed for this many force computations before the simulation
+    size_t _benchmarkKernelRepetitions {0};
+
+    bool _triwise {false};
+
+    // Axilrod-Teller coefficient, default roughly matches argon in reduced units
+    double _nu {0.073};
+
+    // Force computations timed with the pairwise kernel only and with both kernels, 0 disables the baseline
+    size_t _triwiseBaselineRepetitions {0};
 };
\ No newline at end of file
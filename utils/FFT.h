@@ -0,0 +1,97 @@
+/**
+ * @file FFT.h
+ * @date 19.10.2026
+ * @author Luis Gall
+ */
+
+#pragma once
+
+#include <cmath>
+#include <numbers>
+#include <utility>
+#include <vector>
+
+namespace utils::fft {
+
+    using Complex = Kokkos::complex<double>;
+
+    using Grid = Kokkos::View<Complex***, Kokkos::LayoutRight, Kokkos::HostSpace>;
+
+    constexpr bool isPowerOfTwo(size_t n) {
+        return n > 0 and (n & (n - 1)) == 0;
+    }
+
+    /**
+     * In-place iterative radix-2 FFT of length n (power of two), unnormalized.
+     * @param inverse sign of the exponent, false: exp(-2 pi i jk/n), true: exp(+2 pi i jk/n)
+     */
+    inline void fft1d(Complex* data, size_t n, bool inverse) {
+        // Bit reversal permutation
+        for (size_t i = 1, j = 0; i < n; ++i) {
+            size_t bit = n >> 1;
+            for (; j & bit; bit >>= 1) {
+                j ^= bit;
+            }
+            j ^= bit;
+            if (i < j) {
+                std::swap(data[i], data[j]);
+            }
+        }
+
+        for (size_t length = 2; length <= n; length <<= 1) {
+            const double angle = 2. * std::numbers::pi / static_cast<double>(length) * (inverse ? 1. : -1.);
+            const Complex rootOfUnity (std::cos(angle), std::sin(angle));
+            for (size_t start = 0; start < n; start += length) {
+                Complex twiddle (1., 0.);
+                for (size_t k = 0; k < length / 2; ++k) {
+                    const Complex even = data[start + k];
+                    const Complex odd = data[start + k + length / 2] * twiddle;
+                    data[start + k] = even + odd;
+                    data[start + k + length / 2] = even - odd;
+                    twiddle *= rootOfUnity;
+                }
+            }
+        }
+    }
+
+    /**
+     * In-place unnormalized 3D FFT as three passes of 1D transforms. The lines of each pass are distributed over the
+     * host execution space.
+     */
+    inline void fft3d(const Grid& grid, bool inverse) {
+        const size_t n0 = grid.extent(0);
+        const size_t n1 = grid.extent(1);
+        const size_t n2 = grid.extent(2);
+
+        using HostPolicy = Kokkos::MDRangePolicy<Kokkos::DefaultHostExecutionSpace, Kokkos::Rank<2>>;
+
+        // Innermost dimension is contiguous
+        Kokkos::parallel_for("fft3d_dim2", HostPolicy({0, 0}, {n0, n1}), [=](const size_t a, const size_t b) {
+            fft1d(&grid(a, b, 0), n2, inverse);
+        });
+
+        Kokkos::parallel_for("fft3d_dim1", HostPolicy({0, 0}, {n0, n2}), [=](const size_t a, const size_t c) {
+            std::vector<Complex> line (n1);
+            for (size_t b = 0; b < n1; ++b) {
+                line[b] = grid(a, b, c);
+            }
+            fft1d(line.data(), n1, inverse);
+            for (size_t b = 0; b < n1; ++b) {
+                grid(a, b, c) = line[b];
+            }
+        });
+
+        Kokkos::parallel_for("fft3d_dim0", HostPolicy({0, 0}, {n1, n2}), [=](const size_t b, const size_t c) {
+            std::vector<Complex> line (n0);
+            for (size_t a = 0; a < n0; ++a) {
+                line[a] = grid(a, b, c);
+            }
+            fft1d(line.data(), n0, inverse);
+            for (size_t a = 0; a < n0; ++a) {
+                grid(a, b, c) = line[a];
+            }
+        });
+        Kokkos::fence();
+    }
+
+}
@@ -0,0 +1,379 @@
+/**
+ * @file FunctorAxilrodTellerKokkos.h
+ * @date 19.10.2026
+ * @author Luis Gall
+ */
+
+#pragma once
+
+#include "autopas/baseFunctors/TriwiseFunctor.h"
+#include "autopas/utils/SoAView.h"
+
+#include "KokkosParticle.h"
+
+/**
+ * Whether TriwiseFunctor_T takes the memory space as third template argument and declares the Kokkos SoA hooks, as
+ * the TriwiseFunctor of the AutoPas feature/kokkos-direct-sum branch (see cmake/modules/autopas.cmake) does.
+ */
+template <template <class...> class TriwiseFunctor_T, class Particle_T, class Derived, class MemSpace>
+concept KokkosTriwiseFunctorBase = requires(TriwiseFunctor_T<Particle_T, Derived, MemSpace>& functor, const typename Particle_T::KokkosSoAArraysType& soa, bool newton3) {
+    functor.SoAFunctorSingleKokkos(soa, newton3);
+    functor.SoAFunctorPairKokkos(soa, soa, newton3);
+};
+
+/**
+ * autopas::TriwiseFunctor as base class, checked against KokkosTriwiseFunctorBase with the memory space of the functor
+ * before it is used, so an incompatible AutoPas fails with this message instead of an error inside the base class.
+ */
+template <class Particle_T, class Derived, class MemSpace>
+struct CheckedTriwiseFunctorBase {
+    static_assert(KokkosTriwiseFunctorBase<autopas::TriwiseFunctor, Particle_T, Derived, MemSpace>,
+                  "FunctorAxilrodTellerKokkos needs autopas::TriwiseFunctor<Particle, Derived, MemSpace> with SoAFunctorSingleKokkos and "
+                  "SoAFunctorPairKokkos, build against the AutoPas feature/kokkos-direct-sum branch");
+
+    using type = autopas::TriwiseFunctor<Particle_T, Derived, MemSpace>;
+};
+
+/**
+ * Three-body Axilrod-Teller potential on the Kokkos SoA path.
+ *
+ * Every league of the team policy owns one central particle i. The team threads iterate over the second particle j,
+ * triplets are only expanded further if j is within the cutoff of i, so the inner loop over k is skipped for most of
+ * the candidates. With newton3 only triplets with i < j < k are visited and the forces on j and k are added atomically.
+ */
+template <class Particle_T, class MemSpace>
+class FunctorAxilrodTellerKokkos : public CheckedTriwiseFunctorBase<Particle_T, FunctorAxilrodTellerKokkos<Particle_T, MemSpace>, MemSpace>::type {
+
+public:
+    using SoAArraysType = typename Particle_T::SoAArraysType;
+
+    using FloatType = typename Particle_T::ParticleSoAFloatPrecision;
+
+    using TeamPolicy = Kokkos::TeamPolicy<typename MemSpace::execution_space>;
+
+    explicit FunctorAxilrodTellerKokkos(double cutoff, double nu)
+        : CheckedTriwiseFunctorBase<Particle_T, FunctorAxilrodTellerKokkos<Particle_T, MemSpace>, MemSpace>::type(cutoff),
+        _cutoffSquared{cutoff * cutoff},
+        _nu{nu}
+    {}
+
+    /* Overrides for actual execution */
+    void AoSFunctor(Particle_T& i, Particle_T& j, Particle_T& k, bool newton3) final {
+
+    }
+
+    void SoAFunctorSingle(autopas::SoAView<SoAArraysType> soa, bool newton3) final {
+        // No-op as nothing should happen here
+    }
+
+    void SoAFunctorPair(autopas::SoAView<SoAArraysType> soa1, autopas::SoAView<SoAArraysType> soa2, bool newton3) final {
+        // No-op as nothing should happen here
+    }
+
+    void SoAFunctorTriple(autopas::SoAView<SoAArraysType> soa1, autopas::SoAView<SoAArraysType> soa2, autopas::SoAView<SoAArraysType> soa3, bool newton3) final {
+        // No-op as nothing should happen here
+    }
+
+    void SoAFunctorSingleKokkos(const Particle_T::KokkosSoAArraysType& soa, bool newton3) final {
+
+        const size_t N = soa.size();
+        checkReplicaOrder<Particle_T, typename MemSpace::execution_space>(soa, N, "FunctorAxilrodTellerKokkos");
+
+        const FloatType cutoffSquared = static_cast<FloatType>(_cutoffSquared);
+        const FloatType nu = static_cast<FloatType>(_nu);
+
+        Kokkos::parallel_for(TeamPolicy(N, Kokkos::AUTO()), KOKKOS_LAMBDA(const typename TeamPolicy::member_type& team) {
+            const int i = team.league_rank();
+
+            if (isDummyState(soa.template operator()<Particle_T::AttributeNames::ownershipState, true, false>(i))) {
+                return;
+            }
+
+            const auto replicaI = soa.template operator()<Particle_T::AttributeNames::replicaId, true, false>(i);
+            const int replicaBegin = replicaBound<Particle_T, false>(soa, static_cast<int>(N), replicaI);
+            const int replicaEnd = replicaBound<Particle_T, true>(soa, static_cast<int>(N), replicaI);
+            const FloatType xi = soa.template operator()<Particle_T::AttributeNames::posX, true, false>(i);
+            const FloatType yi = soa.template operator()<Particle_T::AttributeNames::posY, true, false>(i);
+            const FloatType zi = soa.template operator()<Particle_T::AttributeNames::posZ, true, false>(i);
+
+            // With newton3 every triplet is visited exactly once (i < j < k), otherwise all (j, k) with j < k and j, k != i.
+            // j and k stay within the slice of the own replica.
+            const int jStart = newton3 ? i + 1 : replicaBegin;
+
+            FloatType fxAcc = 0.;
+            FloatType fyAcc = 0.;
+            FloatType fzAcc = 0.;
+
+            Kokkos::parallel_reduce(Kokkos::TeamThreadRange(team, jStart, replicaEnd), [&](const int j, FloatType& fxLocal, FloatType& fyLocal, FloatType& fzLocal) {
+                if (j == i or isDummyState(soa.template operator()<Particle_T::AttributeNames::ownershipState, true, false>(j))) {
+                    return;
+                }
+
+                const FloatType xj = soa.template operator()<Particle_T::AttributeNames::posX, true, false>(j);
+                const FloatType yj = soa.template operator()<Particle_T::AttributeNames::posY, true, false>(j);
+                const FloatType zj = soa.template operator()<Particle_T::AttributeNames::posZ, true, false>(j);
+
+                const FloatType drIJX = xj - xi;
+                const FloatType drIJY = yj - yi;
+                const FloatType drIJZ = zj - zi;
+                const FloatType distSquaredIJ = drIJX * drIJX + drIJY * drIJY + drIJZ * drIJZ;
+
+                // Cutoff pruning: no triplet containing (i, j) can contribute
+                if (distSquaredIJ > cutoffSquared) {
+                    return;
+                }
+
+                for (int k = j + 1; k < replicaEnd; ++k) {
+                    if (k == i or isDummyState(soa.template operator()<Particle_T::AttributeNames::ownershipState, true, false>(k))) {
+                        continue;
+                    }
+
+                    const FloatType xk = soa.template operator()<Particle_T::AttributeNames::posX, true, false>(k);
+                    const FloatType yk = soa.template operator()<Particle_T::AttributeNames::posY, true, false>(k);
+                    const FloatType zk = soa.template operator()<Particle_T::AttributeNames::posZ, true, false>(k);
+
+                    FloatType forceI[3];
+                    FloatType forceJ[3];
+                    if (not computeTriplet(xi, yi, zi, xj, yj, zj, xk, yk, zk, cutoffSquared, nu, newton3, forceI, forceJ)) {
+                        continue;
+                    }
+
+                    fxLocal += forceI[0];
+                    fyLocal += forceI[1];
+                    fzLocal += forceI[2];
+
+                    if (newton3) {
+                        Kokkos::atomic_add(&soa.template operator()<Particle_T::AttributeNames::forceX, true, false>(j), forceJ[0]);
+                        Kokkos::atomic_add(&soa.template operator()<Particle_T::AttributeNames::forceY, true, false>(j), forceJ[1]);
+                        Kokkos::atomic_add(&soa.template operator()<Particle_T::AttributeNames::forceZ, true, false>(j), forceJ[2]);
+
+                        Kokkos::atomic_add(&soa.template operator()<Particle_T::AttributeNames::forceX, true, false>(k), -(forceI[0] + forceJ[0]));
+                        Kokkos::atomic_add(&soa.template operator()<Particle_T::AttributeNames::forceY, true, false>(k), -(forceI[1] + forceJ[1]));
+                        Kokkos::atomic_add(&soa.template operator()<Particle_T::AttributeNames::forceZ, true, false>(k), -(forceI[2] + forceJ[2]));
+                    }
+                }
+            }, fxAcc, fyAcc, fzAcc);
+
+            Kokkos::single(Kokkos::PerTeam(team), [&]() {
+                addForce(soa, i, fxAcc, fyAcc, fzAcc, newton3);
+            });
+        });
+    }
+
+    void SoAFunctorPairKokkos(const Particle_T::KokkosSoAArraysType& soa1, const Particle_T::KokkosSoAArraysType& soa2, bool newton3) final {
+
+        const size_t N = soa1.size();
+        const size_t M = soa2.size();
+        checkReplicaOrder<Particle_T, typename MemSpace::execution_space>(soa1, N, "FunctorAxilrodTellerKokkos");
+        checkReplicaOrder<Particle_T, typename MemSpace::execution_space>(soa2, M, "FunctorAxilrodTellerKokkos");
+
+        const FloatType cutoffSquared = static_cast<FloatType>(_cutoffSquared);
+        const FloatType nu = static_cast<FloatType>(_nu);
+
+        // Only triplets with at least one particle of soa2 are handled here, the rest is covered by SoAFunctorSingleKokkos.
+        // j runs over the concatenation [soa1, soa2], k always over soa2 (k > j if j is in soa2 as well).
+        Kokkos::parallel_for(TeamPolicy(N, Kokkos::AUTO()), KOKKOS_LAMBDA(const typename TeamPolicy::member_type& team) {
+            const int i = team.league_rank();
+
+            if (isDummyState(soa1.template operator()<Particle_T::AttributeNames::ownershipState, true, false>(i))) {
+                return;
+            }
+
+            const auto replicaI = soa1.template operator()<Particle_T::AttributeNames::replicaId, true, false>(i);
+            const int replicaBegin1 = replicaBound<Particle_T, false>(soa1, static_cast<int>(N), replicaI);
+            const int replicaEnd1 = replicaBound<Particle_T, true>(soa1, static_cast<int>(N), replicaI);
+            const int replicaBegin2 = replicaBound<Particle_T, false>(soa2, static_cast<int>(M), replicaI);
+            const int replicaEnd2 = replicaBound<Particle_T, true>(soa2, static_cast<int>(M), replicaI);
+            const FloatType xi = soa1.template operator()<Particle_T::AttributeNames::posX, true, false>(i);
+            const FloatType yi = soa1.template operator()<Particle_T::AttributeNames::posY, true, false>(i);
+            const FloatType zi = soa1.template operator()<Particle_T::AttributeNames::posZ, true, false>(i);
+
+            // j runs over the replica slices of soa1 (from jStart) and soa2, concatenated
+            const int jStart = newton3 ? i + 1 : replicaBegin1;
+            const int numJ1 = replicaEnd1 - jStart;
+            const int numJ2 = replicaEnd2 - replicaBegin2;
+
+            FloatType fxAcc = 0.;
+            FloatType fyAcc = 0.;
+            FloatType fzAcc = 0.;
+
+            Kokkos::parallel_reduce(Kokkos::TeamThreadRange(team, 0, numJ1 + numJ2), [&](const int jCombined, FloatType& fxLocal, FloatType& fyLocal, FloatType& fzLocal) {
+                const bool jInSoa1 = jCombined < numJ1;
+                const int j = jInSoa1 ? jStart + jCombined : replicaBegin2 + jCombined - numJ1;
+                const auto& soaJ = jInSoa1 ? soa1 : soa2;
+
+                if ((jInSoa1 and j == i) or isDummyState(soaJ.template operator()<Particle_T::AttributeNames::ownershipState, true, false>(j))) {
+                    return;
+                }
+
+                const FloatType xj = soaJ.template operator()<Particle_T::AttributeNames::posX, true, false>(j);
+                const FloatType yj = soaJ.template operator()<Particle_T::AttributeNames::posY, true, false>(j);
+                const FloatType zj = soaJ.template operator()<Particle_T::AttributeNames::posZ, true, false>(j);
+
+                const FloatType drIJX = xj - xi;
+                const FloatType drIJY = yj - yi;
+                const FloatType drIJZ = zj - zi;
+                const FloatType distSquaredIJ = drIJX * drIJX + drIJY * drIJY + drIJZ * drIJZ;
+
+                if (distSquaredIJ > cutoffSquared) {
+                    return;
+                }
+
+                for (int k = jInSoa1 ? replicaBegin2 : j + 1; k < replicaEnd2; ++k) {
+                    if (isDummyState(soa2.template operator()<Particle_T::AttributeNames::ownershipState, true, false>(k))) {
+                        continue;
+                    }
+
+                    const FloatType xk = soa2.template operator()<Particle_T::AttributeNames::posX, true, false>(k);
+                    const FloatType yk = soa2.template operator()<Particle_T::AttributeNames::posY, true, false>(k);
+                    const FloatType zk = soa2.template operator()<Particle_T::AttributeNames::posZ, true, false>(k);
+
+                    FloatType forceI[3];
+                    FloatType forceJ[3];
+                    if (not computeTriplet(xi, yi, zi, xj, yj, zj, xk, yk, zk, cutoffSquared, nu, newton3, forceI, forceJ)) {
+                        continue;
+                    }
+
+                    fxLocal += forceI[0];
+                    fyLocal += forceI[1];
+                    fzLocal += forceI[2];
+
+                    if (newton3) {
+                        Kokkos::atomic_add(&soaJ.template operator()<Particle_T::AttributeNames::forceX, true, false>(j), forceJ[0]);
+                        Kokkos::atomic_add(&soaJ.template operator()<Particle_T::AttributeNames::forceY, true, false>(j), forceJ[1]);
+                        Kokkos::atomic_add(&soaJ.template operator()<Particle_T::AttributeNames::forceZ, true, false>(j), forceJ[2]);
+
+                        Kokkos::atomic_add(&soa2.template operator()<Particle_T::AttributeNames::forceX, true, false>(k), -(forceI[0] + forceJ[0]));
+                        Kokkos::atomic_add(&soa2.template operator()<Particle_T::AttributeNames::forceY, true, false>(k), -(forceI[1] + forceJ[1]));
+                        Kokkos::atomic_add(&soa2.template operator()<Particle_T::AttributeNames::forceZ, true, false>(k), -(forceI[2] + forceJ[2]));
+                    }
+                }
+            }, fxAcc, fyAcc, fzAcc);
+
+            Kokkos::single(Kokkos::PerTeam(team), [&]() {
+                addForce(soa1, i, fxAcc, fyAcc, fzAcc, newton3);
+            });
+        });
+    }
+
+    constexpr static auto getNeededAttr() {
+        return std::array<typename Particle_T::AttributeNames, 8>{
+            Particle_T::AttributeNames::posX,
+            Particle_T::AttributeNames::posY,
+            Particle_T::AttributeNames::posZ,
+            Particle_T::AttributeNames::forceX,
+            Particle_T::AttributeNames::forceY,
+            Particle_T::AttributeNames::forceZ,
+            Particle_T::AttributeNames::replicaId,
+            Particle_T::AttributeNames::ownershipState,
+        };
+    }
+
+    constexpr static auto getNeededAttr(std::false_type) {
+        return std::array<typename Particle_T::AttributeNames, 5>{
+            Particle_T::AttributeNames::posX,
+            Particle_T::AttributeNames::posY,
+            Particle_T::AttributeNames::posZ,
+            Particle_T::AttributeNames::replicaId,
+            Particle_T::AttributeNames::ownershipState};
+    }
+
+    constexpr static auto getComputedAttr() {
+        return std::array<typename Particle_T::AttributeNames, 3>{
+            Particle_T::AttributeNames::forceX,
+            Particle_T::AttributeNames::forceY,
+            Particle_T::AttributeNames::forceZ
+        };
+    }
+
+    /* Interface required stuff */
+    std::string getName() final {
+        return "FunctorAxilrodTellerKokkos";
+    }
+
+    bool isRelevantForTuning() final {
+        return true;
+    }
+
+    bool allowsNewton3() final {
+        return true;
+    }
+
+    bool allowsNonNewton3() final {
+        return true;
+    }
+
+private:
+
+    /**
+     * Computes the Axilrod-Teller force on i (and on j if newton3 is enabled) for the triplet (i, j, k).
+     * The force on k follows from newton3 as -(forceI + forceJ).
+     * @return false if one of the three distances is outside the cutoff
+     */
+    KOKKOS_INLINE_FUNCTION
+    static bool computeTriplet(FloatType xi, FloatType yi, FloatType zi, FloatType xj, FloatType yj, FloatType zj,
+                               FloatType xk, FloatType yk, FloatType zk, FloatType cutoffSquared, FloatType nu, bool newton3,
+                               FloatType (&forceI)[3], FloatType (&forceJ)[3]) {
+
+        const FloatType drIJ[3] = {xj - xi, yj - yi, zj - zi};
+        const FloatType drJK[3] = {xk - xj, yk - yj, zk - zj};
+        const FloatType drKI[3] = {xi - xk, yi - yk, zi - zk};
+
+        const FloatType distSquaredIJ = drIJ[0] * drIJ[0] + drIJ[1] * drIJ[1] + drIJ[2] * drIJ[2];
+        const FloatType distSquaredJK = drJK[0] * drJK[0] + drJK[1] * drJK[1] + drJK[2] * drJK[2];
+        const FloatType distSquaredKI = drKI[0] * drKI[0] + drKI[1] * drKI[1] + drKI[2] * drKI[2];
+
+        if (distSquaredIJ > cutoffSquared or distSquaredJK > cutoffSquared or distSquaredKI > cutoffSquared) {
+            return false;
+        }
+
+        const FloatType IJDotKI = drIJ[0] * drKI[0] + drIJ[1] * drKI[1] + drIJ[2] * drKI[2];
+        const FloatType IJDotJK = drIJ[0] * drJK[0] + drIJ[1] * drJK[1] + drIJ[2] * drJK[2];
+        const FloatType JKDotKI = drJK[0] * drKI[0] + drJK[1] * drKI[1] + drJK[2] * drKI[2];
+        const FloatType allDotProducts = IJDotKI * IJDotJK * JKDotKI;
+
+        const FloatType allDistsSquared = distSquaredIJ * distSquaredJK * distSquaredKI;
+        const FloatType allDistsTo5 = allDistsSquared * allDistsSquared * Kokkos::sqrt(allDistsSquared);
+        const FloatType factor = 3. * nu / allDistsTo5;
+
+        const FloatType factorIJK = IJDotKI * (IJDotJK - JKDotKI);
+        const FloatType factorIIJ = IJDotJK * JKDotKI - distSquaredJK * distSquaredKI + 5. * allDotProducts / distSquaredIJ;
+        const FloatType factorIKI = -IJDotJK * JKDotKI + distSquaredIJ * distSquaredJK - 5. * allDotProducts / distSquaredKI;
+
+        for (int d = 0; d < 3; ++d) {
+            forceI[d] = (drJK[d] * factorIJK + drIJ[d] * factorIIJ + drKI[d] * factorIKI) * factor;
+        }
+
+        if (newton3) {
+            const FloatType factorJKI = IJDotJK * (JKDotKI - IJDotKI);
+            const FloatType factorJIJ = -IJDotKI * JKDotKI + distSquaredJK * distSquaredKI - 5. * allDotProducts / distSquaredIJ;
+            const FloatType factorJJK = IJDotKI * JKDotKI - distSquaredIJ * distSquaredKI + 5. * allDotProducts / distSquaredJK;
+
+            for (int d = 0; d < 3; ++d) {
+                forceJ[d] = (drKI[d] * factorJKI + drIJ[d] * factorJIJ + drJK[d] * factorJJK) * factor;
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * Adds the accumulated force to particle i. With newton3 other teams may concurrently add to the same particle.
+     */
+    KOKKOS_INLINE_FUNCTION
+    static void addForce(const Particle_T::KokkosSoAArraysType& soa, int i, FloatType fx, FloatType fy, FloatType fz, bool newton3) {
+        if (newton3) {
+            Kokkos::atomic_add(&soa.template operator()<Particle_T::AttributeNames::forceX, true, false>(i), fx);
+            Kokkos::atomic_add(&soa.template operator()<Particle_T::AttributeNames::forceY, true, false>(i), fy);
+            Kokkos::atomic_add(&soa.template operator()<Particle_T::AttributeNames::forceZ, true, false>(i), fz);
+        } else {
+            soa.template operator()<Particle_T::AttributeNames::forceX, true, false>(i) += fx;
+            soa.template operator()<Particle_T::AttributeNames::forceY, true, false>(i) += fy;
+            soa.template operator()<Particle_T::AttributeNames::forceZ, true, false>(i) += fz;
+        }
+    }
+
+    double _cutoffSquared;
+
+    double _nu;
+};
@@ -6,19 +6,81 @@
 
 #pragma once
 
+#include <cmath>
+#include <string>
+#include <vector>
+
 #include "autopas/baseFunctors/PairwiseFunctor.h"
 #include "autopas/utils/SoAView.h"
 
-template <class Particle_T, class MemSpace>
-class FunctorKokkos : public autopas::PairwiseFunctor<Particle_T, FunctorKokkos<Particle_T, MemSpace>, MemSpace> {
+#include "KokkosParticle.h"
+
+/**
+ * Lennard-Jones functor on the Kokkos SoA path.
+ *
+ * All options that would otherwise be runtime branches in the inner loop are template parameters, so every
+ * instantiation only contains the code it needs. See KernelVariants.h for the instantiations that are compiled.
+ * @tparam Newton3 visit every pair once and update both particles
+ * @tparam ComputeEnergy accumulate the potential energy of owned particles
+ * @tparam MultiType look up sigma and epsilon by type id instead of using one global pair
+ * @tparam Periodic apply the minimum image convention in a cubic box
+ * @tparam Coulomb add the real-space part of the Ewald sum, q_i q_j erfc(alpha r) / r, the reciprocal part is done by SPME
+ */
+template <class Particle_T, class MemSpace, bool Newton3 = false, bool ComputeEnergy = false, bool MultiType = false, bool Periodic = false, bool Coulomb = false>
+class FunctorKokkos : public autopas::PairwiseFunctor<Particle_T, FunctorKokkos<Particle_T, MemSpace, Newton3, ComputeEnergy, MultiType, Periodic, Coulomb>, MemSpace> {
+
+    using Base = autopas::PairwiseFunctor<Particle_T, FunctorKokkos<Particle_T, MemSpace, Newton3, ComputeEnergy, MultiType, Periodic, Coulomb>, MemSpace>;
 
 public:
     using SoAArraysType = typename Particle_T::SoAArraysType;
 
-    explicit FunctorKokkos(double cutoff)
-        : autopas::PairwiseFunctor<Particle_T, FunctorKokkos<Particle_T, MemSpace>, MemSpace>(cutoff),
-        _cutoffSquared{cutoff * cutoff}
-    {}
+    using FloatType = typename Particle_T::ParticleSoAFloatPrecision;
+
+    using ParameterTable = Kokkos::View<FloatType**, MemSpace>;
+
+    // Template options, e.g. for the reference implementation in Validation.h
+    constexpr static bool usesNewton3 = Newton3;
+
+    constexpr static bool usesComputeEnergy = ComputeEnergy;
+
+    constexpr static bool usesMultiType = MultiType;
+
+    constexpr static bool usesPeriodic = Periodic;
+
+    constexpr static bool usesCoulomb = Coulomb;
+
+    /**
+     * @param cutoff
+     * @param boxLength edge length of the cubic box, only used if Periodic
+     * @param epsilons per type epsilon, only used if MultiType
+     * @param sigmas per type sigma, only used if MultiType
+     * @param ewaldAlpha Ewald splitting parameter, only used if Coulomb
+     */
+    explicit FunctorKokkos(double cutoff, double boxLength = 0., const std::vector<double>& epsilons = {1.}, const std::vector<double>& sigmas = {1.}, double ewaldAlpha = 0.)
+        : Base(cutoff),
+        _cutoffSquared{cutoff * cutoff},
+        _boxLength{boxLength},
+        _ewaldAlpha{ewaldAlpha}
+    {
+        if constexpr (MultiType) {
+            // Lorentz-Berthelot mixing, precomputed for all type pairs
+            const size_t numTypes = epsilons.size();
+            _sigmaSquaredTable = ParameterTable("sigmaSquaredTable", numTypes, numTypes);
+            _epsilon24Table = ParameterTable("epsilon24Table", numTypes, numTypes);
+
+            auto sigmaSquaredHost = Kokkos::create_mirror_view(_sigmaSquaredTable);
+            auto epsilon24Host = Kokkos::create_mirror_view(_epsilon24Table);
+            for (size_t a = 0; a < numTypes; ++a) {
+                for (size_t b = 0; b < numTypes; ++b) {
+                    const double sigma = (sigmas.at(a) + sigmas.at(b)) / 2.;
+                    sigmaSquaredHost(a, b) = static_cast<FloatType>(sigma * sigma);
+                    epsilon24Host(a, b) = static_cast<FloatType>(24. * std::sqrt(epsilons.at(a) * epsilons.at(b)));
+                }
+            }
+            Kokkos::deep_copy(_sigmaSquaredTable, sigmaSquaredHost);
+            Kokkos::deep_copy(_epsilon24Table, epsilon24Host);
+        }
+    }
 
     /* Overrides for actual execution */
     void AoSFunctor(Particle_T& i, Particle_T& j, bool newton3) final {
@@ -33,190 +95,214 @@ public:
         // No-op as nothing should happen here
     }
 
-    void SoAFunctorSingleKokkos(const Particle_T::KokkosSoAArraysType& soa, bool newton3) final {
+    void initTraversal() override {
+        _potentialEnergySum = 0.;
+    }
+
+    // The newton3 argument is ignored in both kernels, allowsNewton3() and allowsNonNewton3() make sure it matches Newton3
+    void SoAFunctorSingleKokkos(const Particle_T::KokkosSoAArraysType& soa, bool /*newton3*/) final {
 
         const size_t N = soa.size();
-        const typename Particle_T::ParticleSoAFloatPrecision cutoffSquared = static_cast<typename Particle_T::ParticleSoAFloatPrecision>(_cutoffSquared);
+        checkReplicaOrder<Particle_T, typename MemSpace::execution_space>(soa, N, "FunctorKokkos");
 
-        //Kokkos::parallel_for(Kokkos::TeamPolicy<typename MemSpace::execution_space>(N, Kokkos::AUTO()), KOKKOS_LAMBDA(Kokkos::TeamPolicy<typename MemSpace::execution_space>::member_type team) {
-        Kokkos::parallel_for(Kokkos::RangePolicy<typename MemSpace::execution_space>(0, N), KOKKOS_LAMBDA(int i) {
-            //int i = team.league_rank();
+        const FloatType cutoffSquared = static_cast<FloatType>(_cutoffSquared);
+        const FloatType boxLength = static_cast<FloatType>(_boxLength);
+        const FloatType ewaldAlpha = static_cast<FloatType>(_ewaldAlpha);
+        const ParameterTable sigmaSquaredTable = _sigmaSquaredTable;
+        const ParameterTable epsilon24Table = _epsilon24Table;
+
+        auto kernel = KOKKOS_LAMBDA(int i, double& energyLocal) {
 
             const auto owned1 = soa.template operator()<Particle_T::AttributeNames::ownershipState, true, false>(i);
 
-            if (owned1 != autopas::OwnershipState::dummy) {
-                typename Particle_T::ParticleSoAFloatPrecision fxAcc = 0.;
-                typename Particle_T::ParticleSoAFloatPrecision fyAcc = 0.;
-                typename Particle_T::ParticleSoAFloatPrecision fzAcc = 0.;
-
-                const typename Particle_T::ParticleSoAFloatPrecision x1 = soa.template operator()<Particle_T::AttributeNames::posX, true, false>(i);
-                const typename Particle_T::ParticleSoAFloatPrecision y1 = soa.template operator()<Particle_T::AttributeNames::posY, true, false>(i);
-                const typename Particle_T::ParticleSoAFloatPrecision z1 = soa.template operator()<Particle_T::AttributeNames::posZ, true, false>(i);
-
-                for (int j = 0; j < N; ++j) {
-                    if (i != j) {
-
-                        const auto owned2 = soa.template operator()<Particle_T::AttributeNames::ownershipState, true, false>(j);
-
-                        if (owned2 != autopas::OwnershipState::dummy) {
-                            const typename Particle_T::ParticleSoAFloatPrecision x2 = soa.template operator()<Particle_T::AttributeNames::posX, true, false>(j);
-                            const typename Particle_T::ParticleSoAFloatPrecision y2 = soa.template operator()<Particle_T::AttributeNames::posY, true, false>(j);
-                            const typename Particle_T::ParticleSoAFloatPrecision z2 = soa.template operator()<Particle_T::AttributeNames::posZ, true, false>(j);
-
-                            const typename Particle_T::ParticleSoAFloatPrecision drX = x1 - x2;
-                            const typename Particle_T::ParticleSoAFloatPrecision drY = y1 - y2;
-                            const typename Particle_T::ParticleSoAFloatPrecision drZ = z1 - z2;
-
-                            const typename Particle_T::ParticleSoAFloatPrecision drX2 = drX * drX;
-                            const typename Particle_T::ParticleSoAFloatPrecision drY2 = drY * drY;
-                            const typename Particle_T::ParticleSoAFloatPrecision drZ2 = drZ * drZ;
-
-                            const typename Particle_T::ParticleSoAFloatPrecision dr2 = drX2 + drY2 + drZ2;
-
-                            if (dr2 <= cutoffSquared) {
-                                // TODO: consider mixing based on type or some sort of parameter injection
-                                const typename Particle_T::ParticleSoAFloatPrecision sigmaSquared = 1.;
-                                const typename Particle_T::ParticleSoAFloatPrecision epsilon24 = 24.;
-
-                                const typename Particle_T::ParticleSoAFloatPrecision invDr2 = 1.0 / dr2;
-                                typename Particle_T::ParticleSoAFloatPrecision lj6 = sigmaSquared * invDr2;
-                                lj6 = lj6 * lj6 * lj6;
-                                const typename Particle_T::ParticleSoAFloatPrecision lj12 = lj6 * lj6;
-                                const typename Particle_T::ParticleSoAFloatPrecision lj12m6 = lj12 - lj6;
-                                const typename Particle_T::ParticleSoAFloatPrecision fac = epsilon24 * (lj12 + lj12m6) * invDr2;
-
-                                const typename Particle_T::ParticleSoAFloatPrecision fX = fac * drX;
-                                const typename Particle_T::ParticleSoAFloatPrecision fY = fac * drY;
-                                const typename Particle_T::ParticleSoAFloatPrecision fZ = fac * drZ;
-
-                                // TODO: consider newton3 if enabled
-                                fxAcc += fX;
-                                fxAcc += fY;
-                                fzAcc += fZ;
-                            }
-                        }
-                    }
+            if (isDummyState(owned1)) {
+                return;
+            }
+
+            const auto replica1 = soa.template operator()<Particle_T::AttributeNames::replicaId, true, false>(i);
+            const int replicaBegin = replicaBound<Particle_T, false>(soa, static_cast<int>(N), replica1);
+            const int replicaEnd = replicaBound<Particle_T, true>(soa, static_cast<int>(N), replica1);
+            const auto type1 = MultiType ? soa.template operator()<Particle_T::AttributeNames::typeId, true, false>(i) : 0;
+            const FloatType charge1 = Coulomb ? soa.template operator()<Particle_T::AttributeNames::charge, true, false>(i) : 0.;
+
+            FloatType fxAcc = 0.;
+            FloatType fyAcc = 0.;
+            FloatType fzAcc = 0.;
+
+            const FloatType x1 = soa.template operator()<Particle_T::AttributeNames::posX, true, false>(i);
+            const FloatType y1 = soa.template operator()<Particle_T::AttributeNames::posY, true, false>(i);
+            const FloatType z1 = soa.template operator()<Particle_T::AttributeNames::posZ, true, false>(i);
+
+            const auto interact = [&](int j) {
+                const auto owned2 = soa.template operator()<Particle_T::AttributeNames::ownershipState, true, false>(j);
+                if (isDummyState(owned2)) {
+                    return;
                 }
-                //}, fxAcc, fyAcc, fzAcc);
-                //team.team_barrier();
 
-                const typename Particle_T::ParticleSoAFloatPrecision oldFx = soa.template operator()<Particle_T::AttributeNames::forceX, true, false>(i);
-                const typename Particle_T::ParticleSoAFloatPrecision oldFy = soa.template operator()<Particle_T::AttributeNames::forceY, true, false>(i);
-                const typename Particle_T::ParticleSoAFloatPrecision oldFz = soa.template operator()<Particle_T::AttributeNames::forceZ, true, false>(i);
+                const auto type2 = MultiType ? soa.template operator()<Particle_T::AttributeNames::typeId, true, false>(j) : 0;
+                const FloatType charge2 = Coulomb ? soa.template operator()<Particle_T::AttributeNames::charge, true, false>(j) : 0.;
 
-                const typename Particle_T::ParticleSoAFloatPrecision newFx = oldFx + fxAcc;
-                const typename Particle_T::ParticleSoAFloatPrecision newFy = oldFy + fyAcc;
-                const typename Particle_T::ParticleSoAFloatPrecision newFz = oldFz + fzAcc;
+                FloatType drX = x1 - soa.template operator()<Particle_T::AttributeNames::posX, true, false>(j);
+                FloatType drY = y1 - soa.template operator()<Particle_T::AttributeNames::posY, true, false>(j);
+                FloatType drZ = z1 - soa.template operator()<Particle_T::AttributeNames::posZ, true, false>(j);
+
+                FloatType fac = 0.;
+                FloatType upot = 0.;
+                if (not computePair(drX, drY, drZ, cutoffSquared, boxLength, sigmaSquaredTable, epsilon24Table, type1, type2, charge1 * charge2, ewaldAlpha, fac, upot)) {
+                    return;
+                }
 
-                soa.template operator()<Particle_T::AttributeNames::forceX, true, false>(i) = newFx;
-                soa.template operator()<Particle_T::AttributeNames::forceY, true, false>(i) = newFy;
-                soa.template operator()<Particle_T::AttributeNames::forceZ, true, false>(i) = newFz;
+                const FloatType fX = fac * drX;
+                const FloatType fY = fac * drY;
+                const FloatType fZ = fac * drZ;
+
+                fxAcc += fX;
+                fyAcc += fY;
+                fzAcc += fZ;
+
+                if constexpr (Newton3) {
+                    Kokkos::atomic_sub(&soa.template operator()<Particle_T::AttributeNames::forceX, true, false>(j), fX);
+                    Kokkos::atomic_sub(&soa.template operator()<Particle_T::AttributeNames::forceY, true, false>(j), fY);
+                    Kokkos::atomic_sub(&soa.template operator()<Particle_T::AttributeNames::forceZ, true, false>(j), fZ);
+                }
+
+                if constexpr (ComputeEnergy) {
+                    // Every owned particle gets half of the pair energy, without newton3 each pair is visited twice
+                    energyLocal += isOwnedState(owned1) ? 0.5 * upot : 0.;
+                    if constexpr (Newton3) {
+                        energyLocal += isOwnedState(owned2) ? 0.5 * upot : 0.;
+                    }
+                }
+            };
+
+            // Splitting the loop at i instead of checking i != j in every iteration, only the slice of the own replica
+            if constexpr (not Newton3) {
+                for (int j = replicaBegin; j < i; ++j) {
+                    interact(j);
+                }
             }
-        });
+            for (int j = i + 1; j < replicaEnd; ++j) {
+                interact(j);
+            }
+
+            if constexpr (Newton3) {
+                // Other iterations add their reaction forces to i concurrently
+                Kokkos::atomic_add(&soa.template operator()<Particle_T::AttributeNames::forceX, true, false>(i), fxAcc);
+                Kokkos::atomic_add(&soa.template operator()<Particle_T::AttributeNames::forceY, true, false>(i), fyAcc);
+                Kokkos::atomic_add(&soa.template operator()<Particle_T::AttributeNames::forceZ, true, false>(i), fzAcc);
+            } else {
+                soa.template operator()<Particle_T::AttributeNames::forceX, true, false>(i) += fxAcc;
+                soa.template operator()<Particle_T::AttributeNames::forceY, true, false>(i) += fyAcc;
+                soa.template operator()<Particle_T::AttributeNames::forceZ, true, false>(i) += fzAcc;
+            }
+        };
+
+        launch(N, kernel);
     }
 
-    void SoAFunctorPairKokkos(const Particle_T::KokkosSoAArraysType& soa1, const Particle_T::KokkosSoAArraysType& soa2, bool newton3) final {
+    void SoAFunctorPairKokkos(const Particle_T::KokkosSoAArraysType& soa1, const Particle_T::KokkosSoAArraysType& soa2, bool /*newton3*/) final {
         const size_t N = soa1.size();
         const size_t M = soa2.size();
+        checkReplicaOrder<Particle_T, typename MemSpace::execution_space>(soa2, M, "FunctorKokkos");
 
-        const typename Particle_T::ParticleSoAFloatPrecision cutoffSquared = static_cast<typename Particle_T::ParticleSoAFloatPrecision>(_cutoffSquared);
+        const FloatType cutoffSquared = static_cast<FloatType>(_cutoffSquared);
+        const FloatType boxLength = static_cast<FloatType>(_boxLength);
+        const FloatType ewaldAlpha = static_cast<FloatType>(_ewaldAlpha);
+        const ParameterTable sigmaSquaredTable = _sigmaSquaredTable;
+        const ParameterTable epsilon24Table = _epsilon24Table;
 
-        //Kokkos::TeamPolicy<typename MemSpace::execution_space> policy (N, Kokkos::AUTO());
-
-        Kokkos::parallel_for(Kokkos::RangePolicy<typename MemSpace::execution_space>(0, N), KOKKOS_LAMBDA(int i) {
-            //int i = team.league_rank();
+        auto kernel = KOKKOS_LAMBDA(int i, double& energyLocal) {
 
             const auto owned1 = soa1.template operator()<Particle_T::AttributeNames::ownershipState, true, false>(i);
 
-            if (owned1 != autopas::OwnershipState::dummy) {
-                typename Particle_T::ParticleSoAFloatPrecision fxAcc = 0.;
-                typename Particle_T::ParticleSoAFloatPrecision fyAcc = 0.;
-                typename Particle_T::ParticleSoAFloatPrecision fzAcc = 0.;
-
-                const typename Particle_T::ParticleSoAFloatPrecision x1 = soa1.template operator()<Particle_T::AttributeNames::posX, true, false>(i);
-                const typename Particle_T::ParticleSoAFloatPrecision y1 = soa1.template operator()<Particle_T::AttributeNames::posY, true, false>(i);
-                const typename Particle_T::ParticleSoAFloatPrecision z1 = soa1.template operator()<Particle_T::AttributeNames::posZ, true, false>(i);
-
-                for (int j = 0; j < M; ++j) {
-                    const auto owned2 = soa2.template operator()<Particle_T::AttributeNames::ownershipState, true, false>(j);
-
-                    if (owned2 != autopas::OwnershipState::dummy) {
-                        const typename Particle_T::ParticleSoAFloatPrecision x2 = soa2.template operator()<Particle_T::AttributeNames::posX, true, false>(j);
-                        const typename Particle_T::ParticleSoAFloatPrecision y2 = soa2.template operator()<Particle_T::AttributeNames::posY, true, false>(j);
-                        const typename Particle_T::ParticleSoAFloatPrecision z2 = soa2.template operator()<Particle_T::AttributeNames::posZ, true, false>(j);
-
-                        const typename Particle_T::ParticleSoAFloatPrecision drX = x1 - x2;
-                        const typename Particle_T::ParticleSoAFloatPrecision drY = y1 - y2;
-                        const typename Particle_T::ParticleSoAFloatPrecision drZ = z1 - z2;
-
-                        const typename Particle_T::ParticleSoAFloatPrecision drX2 = drX * drX;
-                        const typename Particle_T::ParticleSoAFloatPrecision drY2 = drY * drY;
-                        const typename Particle_T::ParticleSoAFloatPrecision drZ2 = drZ * drZ;
-
-                        const typename Particle_T::ParticleSoAFloatPrecision dr2 = drX2 + drY2 + drZ2;
-
-                        if (dr2 <= cutoffSquared) {
-                            // TODO: consider mixing based on type or some sort of parameter injection
-                            const typename Particle_T::ParticleSoAFloatPrecision sigmaSquared = 1.;
-                            const typename Particle_T::ParticleSoAFloatPrecision epsilon24 = 24.;
-
-                            const typename Particle_T::ParticleSoAFloatPrecision invDr2 = 1.0 / dr2;
-                            typename Particle_T::ParticleSoAFloatPrecision lj6 = sigmaSquared * invDr2;
-                            lj6 = lj6 * lj6 * lj6;
-                            const typename Particle_T::ParticleSoAFloatPrecision lj12 = lj6 * lj6;
-                            const typename Particle_T::ParticleSoAFloatPrecision lj12m6 = lj12 - lj6;
-                            const typename Particle_T::ParticleSoAFloatPrecision fac = epsilon24 * (lj12 + lj12m6) * invDr2;
-
-                            const typename Particle_T::ParticleSoAFloatPrecision fX = fac * drX;
-                            const typename Particle_T::ParticleSoAFloatPrecision fY = fac * drY;
-                            const typename Particle_T::ParticleSoAFloatPrecision fZ = fac * drZ;
-
-                            // TODO: consider newton3 if enabled
-                            fxAcc += fX;
-                            fyAcc += fY;
-                            fzAcc += fZ;
-                        }
-                    }
-                //}, fxAcc, fyAcc, fzAcc);
+            if (isDummyState(owned1)) {
+                return;
+            }
+
+            const auto replica1 = soa1.template operator()<Particle_T::AttributeNames::replicaId, true, false>(i);
+            const int replicaBegin = replicaBound<Particle_T, false>(soa2, static_cast<int>(M), replica1);
+            const int replicaEnd = replicaBound<Particle_T, true>(soa2, static_cast<int>(M), replica1);
+            const auto type1 = MultiType ? soa1.template operator()<Particle_T::AttributeNames::typeId, true, false>(i) : 0;
+            const FloatType charge1 = Coulomb ? soa1.template operator()<Particle_T::AttributeNames::charge, true, false>(i) : 0.;
+
+            FloatType fxAcc = 0.;
+            FloatType fyAcc = 0.;
+            FloatType fzAcc = 0.;
+
+            const FloatType x1 = soa1.template operator()<Particle_T::AttributeNames::posX, true, false>(i);
+            const FloatType y1 = soa1.template operator()<Particle_T::AttributeNames::posY, true, false>(i);
+            const FloatType z1 = soa1.template operator()<Particle_T::AttributeNames::posZ, true, false>(i);
+
+            for (int j = replicaBegin; j < replicaEnd; ++j) {
+                const auto owned2 = soa2.template operator()<Particle_T::AttributeNames::ownershipState, true, false>(j);
+                if (isDummyState(owned2)) {
+                    continue;
+                }
+
+                const auto type2 = MultiType ? soa2.template operator()<Particle_T::AttributeNames::typeId, true, false>(j) : 0;
+                const FloatType charge2 = Coulomb ? soa2.template operator()<Particle_T::AttributeNames::charge, true, false>(j) : 0.;
+
+                FloatType drX = x1 - soa2.template operator()<Particle_T::AttributeNames::posX, true, false>(j);
+                FloatType drY = y1 - soa2.template operator()<Particle_T::AttributeNames::posY, true, false>(j);
+                FloatType drZ = z1 - soa2.template operator()<Particle_T::AttributeNames::posZ, true, false>(j);
+
+                FloatType fac = 0.;
+                FloatType upot = 0.;
+                if (not computePair(drX, drY, drZ, cutoffSquared, boxLength, sigmaSquaredTable, epsilon24Table, type1, type2, charge1 * charge2, ewaldAlpha, fac, upot)) {
+                    continue;
                 }
 
-                const typename Particle_T::ParticleSoAFloatPrecision oldFx = soa1.template operator()<Particle_T::AttributeNames::forceX, true, false>(i);
-                const typename Particle_T::ParticleSoAFloatPrecision oldFy = soa1.template operator()<Particle_T::AttributeNames::forceY, true, false>(i);
-                const typename Particle_T::ParticleSoAFloatPrecision oldFz = soa1.template operator()<Particle_T::AttributeNames::forceZ, true, false>(i);
+                const FloatType fX = fac * drX;
+                const FloatType fY = fac * drY;
+                const FloatType fZ = fac * drZ;
 
-                const typename Particle_T::ParticleSoAFloatPrecision newFx = oldFx + fxAcc;
-                const typename Particle_T::ParticleSoAFloatPrecision newFy = oldFy + fyAcc;
-                const typename Particle_T::ParticleSoAFloatPrecision newFz = oldFz + fzAcc;
+                fxAcc += fX;
+                fyAcc += fY;
+                fzAcc += fZ;
 
-                soa1.template operator()<Particle_T::AttributeNames::forceX, true, false>(i) = newFx;
-                soa1.template operator()<Particle_T::AttributeNames::forceY, true, false>(i) = newFy;
-                soa1.template operator()<Particle_T::AttributeNames::forceZ, true, false>(i) = newFz;
+                if constexpr (Newton3) {
+                    Kokkos::atomic_sub(&soa2.template operator()<Particle_T::AttributeNames::forceX, true, false>(j), fX);
+                    Kokkos::atomic_sub(&soa2.template operator()<Particle_T::AttributeNames::forceY, true, false>(j), fY);
+                    Kokkos::atomic_sub(&soa2.template operator()<Particle_T::AttributeNames::forceZ, true, false>(j), fZ);
+                }
+
+                if constexpr (ComputeEnergy) {
+                    energyLocal += isOwnedState(owned1) ? 0.5 * upot : 0.;
+                    if constexpr (Newton3) {
+                        energyLocal += isOwnedState(owned2) ? 0.5 * upot : 0.;
+                    }
+                }
             }
-        });
+
+            // i is only written by this iteration, soa2 is a different cell
+            soa1.template operator()<Particle_T::AttributeNames::forceX, true, false>(i) += fxAcc;
+            soa1.template operator()<Particle_T::AttributeNames::forceY, true, false>(i) += fyAcc;
+            soa1.template operator()<Particle_T::AttributeNames::forceZ, true, false>(i) += fzAcc;
+        };
+
+        launch(N, kernel);
     }
 
     constexpr static auto getNeededAttr() {
-        return std::array<typename Particle_T::AttributeNames, 9>{
-            Particle_T::AttributeNames::id,
+        return appendOptionalAttr(std::array<typename Particle_T::AttributeNames, 8>{
             Particle_T::AttributeNames::posX,
             Particle_T::AttributeNames::posY,
             Particle_T::AttributeNames::posZ,
             Particle_T::AttributeNames::forceX,
             Particle_T::AttributeNames::forceY,
             Particle_T::AttributeNames::forceZ,
-            Particle_T::AttributeNames::typeId,
+            Particle_T::AttributeNames::replicaId,
             Particle_T::AttributeNames::ownershipState,
-        };
+        });
     }
 
     constexpr static auto getNeededAttr(std::false_type) {
-        return std::array<typename Particle_T::AttributeNames, 6>{
-            Particle_T::AttributeNames::id,
+        return appendOptionalAttr(std::array<typename Particle_T::AttributeNames, 5>{
             Particle_T::AttributeNames::posX,
             Particle_T::AttributeNames::posY,
             Particle_T::AttributeNames::posZ,
-            Particle_T::AttributeNames::typeId,
-            Particle_T::AttributeNames::ownershipState};
+            Particle_T::AttributeNames::replicaId,
+            Particle_T::AttributeNames::ownershipState});
     }
 
     constexpr static auto getComputedAttr() {
@@ -227,6 +313,21 @@ public:
         };
     }
 
+    /**
+     * Potential energy accumulated since the last initTraversal(), zero unless ComputeEnergy.
+     */
+    double getPotentialEnergy() const {
+        return _potentialEnergySum;
+    }
+
+    /**
+     * Name including the template parameters, used to label the kernel variants in the output.
+     */
+    static std::string getVariantName() {
+        return std::string("FunctorKokkos<Newton3=") + (Newton3 ? "1" : "0") + ",ComputeEnergy=" + (ComputeEnergy ? "1" : "0")
+            + ",MultiType=" + (MultiType ? "1" : "0") + ",Periodic=" + (Periodic ? "1" : "0") + ",Coulomb=" + (Coulomb ? "1" : "0") + ">";
+    }
+
     /* Interface required stuff */
     std::string getName() final {
         return "FunctorKokkos";
@@ -237,16 +338,116 @@ public:
     }
 
     bool allowsNewton3() final {
-        // TODO
-        return true;
+        return Newton3;
     }
 
     bool allowsNonNewton3() final {
-        // TODO
-        return true;
+        return not Newton3;
     }
 
 private:
 
+    /**
+     * Adds typeId and charge to the attribute list if the variant reads them.
+     */
+    template <size_t N>
+    constexpr static auto appendOptionalAttr(const std::array<typename Particle_T::AttributeNames, N>& attributes) {
+        constexpr size_t numOptional = (MultiType ? 1 : 0) + (Coulomb ? 1 : 0);
+        std::array<typename Particle_T::AttributeNames, N + numOptional> result {};
+        size_t index = 0;
+        for (const auto attribute : attributes) {
+            result[index++] = attribute;
+        }
+        if constexpr (MultiType) {
+            result[index++] = Particle_T::AttributeNames::typeId;
+        }
+        if constexpr (Coulomb) {
+            result[index++] = Particle_T::AttributeNames::charge;
+        }
+        return result;
+    }
+
+    /**
+     * Runs kernel over [0, N), with a reduction only if the energy is needed.
+     */
+    template <class Kernel>
+    void launch(size_t N, const Kernel& kernel) {
+        if constexpr (ComputeEnergy) {
+            double energy = 0.;
+            Kokkos::parallel_reduce(Kokkos::RangePolicy<typename MemSpace::execution_space>(0, N), kernel, energy);
+            _potentialEnergySum += energy;
+        } else {
+            Kokkos::parallel_for(Kokkos::RangePolicy<typename MemSpace::execution_space>(0, N), KOKKOS_LAMBDA(int i) {
+                double unused = 0.;
+                kernel(i, unused);
+            });
+        }
+    }
+
+    /**
+     * Lennard-Jones (and real-space Ewald) interaction of one pair. Applies the minimum image to the distance vector if Periodic.
+     * @return false if the pair is outside the cutoff
+     */
+    template <class TypeIdType>
+    KOKKOS_INLINE_FUNCTION
+    static bool computePair(FloatType& drX, FloatType& drY, FloatType& drZ, FloatType cutoffSquared, FloatType boxLength,
+                            const ParameterTable& sigmaSquaredTable, const ParameterTable& epsilon24Table,
+                            TypeIdType type1, TypeIdType type2, FloatType chargeProduct, FloatType ewaldAlpha, FloatType& fac, FloatType& upot) {
+
+        if constexpr (Periodic) {
+            drX -= boxLength * Kokkos::round(drX / boxLength);
+            drY -= boxLength * Kokkos::round(drY / boxLength);
+            drZ -= boxLength * Kokkos::round(drZ / boxLength);
+        }
+
+        const FloatType dr2 = drX * drX + drY * drY + drZ * drZ;
+
+        if (dr2 > cutoffSquared) {
+            return false;
+        }
+
+        FloatType sigmaSquared = 1.;
+        FloatType epsilon24 = 24.;
+        if constexpr (MultiType) {
+            sigmaSquared = sigmaSquaredTable(type1, type2);
+            epsilon24 = epsilon24Table(type1, type2);
+        }
+
+        const FloatType invDr2 = 1.0 / dr2;
+        FloatType lj6 = sigmaSquared * invDr2;
+        lj6 = lj6 * lj6 * lj6;
+        const FloatType lj12 = lj6 * lj6;
+        const FloatType lj12m6 = lj12 - lj6;
+        fac = epsilon24 * (lj12 + lj12m6) * invDr2;
+
+        if constexpr (ComputeEnergy) {
+            // 4 * epsilon * (lj12 - lj6)
+            upot = epsilon24 * lj12m6 / 6.;
+        }
+
+        if constexpr (Coulomb) {
+            constexpr FloatType twoOverSqrtPi = 1.1283791670955126;
+            const FloatType dr = Kokkos::sqrt(dr2);
+            const FloatType alphaDr = ewaldAlpha * dr;
+            const FloatType erfcTerm = chargeProduct * Kokkos::erfc(alphaDr) / dr;
+            fac += (erfcTerm + chargeProduct * twoOverSqrtPi * ewaldAlpha * Kokkos::exp(-alphaDr * alphaDr)) * invDr2;
+            if constexpr (ComputeEnergy) {
+                upot += erfcTerm;
+            }
+        }
+
+        return true;
+    }
+
     double _cutoffSquared;
-};
\ No newline at end of file
+
+    double _boxLength;
+
+    double _ewaldAlpha;
+
+    ParameterTable _sigmaSquaredTable {};
+
+    ParameterTable _epsilon24Table {};
+
+    double _potentialEnergySum {0.};
+};
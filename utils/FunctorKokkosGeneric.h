@@ -0,0 +1,411 @@
+/**
+ * @file FunctorKokkosGeneric.h
+ * @date 19.10.2026
+ * @author Luis Gall
+ */
+
+#pragma once
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "autopas/baseFunctors/PairwiseFunctor.h"
+#include "autopas/utils/SoAView.h"
+
+#include "KokkosParticle.h"
+
+/**
+ * Lennard-Jones functor with the same physics as FunctorKokkos, but every option is a runtime branch in the inner loop.
+ *
+ * Always compiled as the baseline of --benchmarkKernels and AutoPasSimulatorKernelBenchmark, so the gain of each
+ * FunctorKokkos specialization is measured against the kernel it replaces. Not counted by the variant budget.
+ */
+template <class Particle_T, class MemSpace>
+class FunctorKokkosGeneric : public autopas::PairwiseFunctor<Particle_T, FunctorKokkosGeneric<Particle_T, MemSpace>, MemSpace> {
+
+    using Base = autopas::PairwiseFunctor<Particle_T, FunctorKokkosGeneric<Particle_T, MemSpace>, MemSpace>;
+
+public:
+    using SoAArraysType = typename Particle_T::SoAArraysType;
+
+    using FloatType = typename Particle_T::ParticleSoAFloatPrecision;
+
+    using ParameterTable = Kokkos::View<FloatType**, MemSpace>;
+
+    /**
+     * Same parameters as FunctorKokkos, followed by its template options.
+     */
+    FunctorKokkosGeneric(double cutoff, double boxLength, const std::vector<double>& epsilons, const std::vector<double>& sigmas, double ewaldAlpha,
+                         bool newton3, bool computeEnergy, bool multiType, bool periodic, bool coulomb)
+        : Base(cutoff),
+        _cutoffSquared{cutoff * cutoff},
+        _boxLength{boxLength},
+        _ewaldAlpha{ewaldAlpha},
+        _newton3{newton3},
+        _computeEnergy{computeEnergy},
+        _multiType{multiType},
+        _periodic{periodic},
+        _coulomb{coulomb}
+    {
+        // Lorentz-Berthelot mixing, a single type without MultiType
+        const size_t numTypes = multiType ? epsilons.size() : 1;
+        _sigmaSquaredTable = ParameterTable("sigmaSquaredTable", numTypes, numTypes);
+        _epsilon24Table = ParameterTable("epsilon24Table", numTypes, numTypes);
+
+        auto sigmaSquaredHost = Kokkos::create_mirror_view(_sigmaSquaredTable);
+        auto epsilon24Host = Kokkos::create_mirror_view(_epsilon24Table);
+        for (size_t a = 0; a < numTypes; ++a) {
+            for (size_t b = 0; b < numTypes; ++b) {
+                const double sigma = multiType ? (sigmas.at(a) + sigmas.at(b)) / 2. : 1.;
+                sigmaSquaredHost(a, b) = static_cast<FloatType>(sigma * sigma);
+                epsilon24Host(a, b) = static_cast<FloatType>(multiType ? 24. * std::sqrt(epsilons.at(a) * epsilons.at(b)) : 24.);
+            }
+        }
+        Kokkos::deep_copy(_sigmaSquaredTable, sigmaSquaredHost);
+        Kokkos::deep_copy(_epsilon24Table, epsilon24Host);
+    }
+
+    /* Overrides for actual execution */
+    void AoSFunctor(Particle_T& i, Particle_T& j, bool newton3) final {
+
+    }
+
+    void SoAFunctorSingle(autopas::SoAView<SoAArraysType> soa, bool newton3) final {
+        // No-op as nothing should happen here
+    }
+
+    void SoAFunctorPair(autopas::SoAView<SoAArraysType> soa1, autopas::SoAView<SoAArraysType> soa2, bool newton3) final {
+        // No-op as nothing should happen here
+    }
+
+    void initTraversal() override {
+        _potentialEnergySum = 0.;
+    }
+
+    void SoAFunctorSingleKokkos(const Particle_T::KokkosSoAArraysType& soa, bool /*newton3*/) final {
+
+        const size_t N = soa.size();
+        checkReplicaOrder<Particle_T, typename MemSpace::execution_space>(soa, N, "FunctorKokkosGeneric");
+
+        const FloatType cutoffSquared = static_cast<FloatType>(_cutoffSquared);
+        const FloatType boxLength = static_cast<FloatType>(_boxLength);
+        const FloatType ewaldAlpha = static_cast<FloatType>(_ewaldAlpha);
+        const ParameterTable sigmaSquaredTable = _sigmaSquaredTable;
+        const ParameterTable epsilon24Table = _epsilon24Table;
+        const bool newton3 = _newton3;
+        const bool computeEnergy = _computeEnergy;
+        const bool multiType = _multiType;
+        const bool periodic = _periodic;
+        const bool coulomb = _coulomb;
+
+        double energy = 0.;
+        Kokkos::parallel_reduce(Kokkos::RangePolicy<typename MemSpace::execution_space>(0, N), KOKKOS_LAMBDA(int i, double& energyLocal) {
+
+            const auto owned1 = soa.template operator()<Particle_T::AttributeNames::ownershipState, true, false>(i);
+
+            if (isDummyState(owned1)) {
+                return;
+            }
+
+            const auto replica1 = soa.template operator()<Particle_T::AttributeNames::replicaId, true, false>(i);
+            const int replicaBegin = replicaBound<Particle_T, false>(soa, static_cast<int>(N), replica1);
+            const int replicaEnd = replicaBound<Particle_T, true>(soa, static_cast<int>(N), replica1);
+            const auto type1 = soa.template operator()<Particle_T::AttributeNames::typeId, true, false>(i);
+            const FloatType charge1 = soa.template operator()<Particle_T::AttributeNames::charge, true, false>(i);
+
+            FloatType fxAcc = 0.;
+            FloatType fyAcc = 0.;
+            FloatType fzAcc = 0.;
+
+            const FloatType x1 = soa.template operator()<Particle_T::AttributeNames::posX, true, false>(i);
+            const FloatType y1 = soa.template operator()<Particle_T::AttributeNames::posY, true, false>(i);
+            const FloatType z1 = soa.template operator()<Particle_T::AttributeNames::posZ, true, false>(i);
+
+            // With newton3 only the pairs after i, without all pairs except i itself
+            for (int j = newton3 ? i + 1 : replicaBegin; j < replicaEnd; ++j) {
+                const auto owned2 = soa.template operator()<Particle_T::AttributeNames::ownershipState, true, false>(j);
+                if (j == i or isDummyState(owned2)) {
+                    continue;
+                }
+
+                const auto type2 = soa.template operator()<Particle_T::AttributeNames::typeId, true, false>(j);
+                const FloatType charge2 = soa.template operator()<Particle_T::AttributeNames::charge, true, false>(j);
+
+                FloatType drX = x1 - soa.template operator()<Particle_T::AttributeNames::posX, true, false>(j);
+                FloatType drY = y1 - soa.template operator()<Particle_T::AttributeNames::posY, true, false>(j);
+                FloatType drZ = z1 - soa.template operator()<Particle_T::AttributeNames::posZ, true, false>(j);
+
+                FloatType fac = 0.;
+                FloatType upot = 0.;
+                if (not computePair(drX, drY, drZ, cutoffSquared, boxLength, sigmaSquaredTable, epsilon24Table, multiType ? type1 : 0, multiType ? type2 : 0,
+                                    charge1 * charge2, ewaldAlpha, computeEnergy, periodic, coulomb, fac, upot)) {
+                    continue;
+                }
+
+                const FloatType fX = fac * drX;
+                const FloatType fY = fac * drY;
+                const FloatType fZ = fac * drZ;
+
+                fxAcc += fX;
+                fyAcc += fY;
+                fzAcc += fZ;
+
+                if (newton3) {
+                    Kokkos::atomic_sub(&soa.template operator()<Particle_T::AttributeNames::forceX, true, false>(j), fX);
+                    Kokkos::atomic_sub(&soa.template operator()<Particle_T::AttributeNames::forceY, true, false>(j), fY);
+                    Kokkos::atomic_sub(&soa.template operator()<Particle_T::AttributeNames::forceZ, true, false>(j), fZ);
+                }
+
+                if (computeEnergy) {
+                    energyLocal += isOwnedState(owned1) ? 0.5 * upot : 0.;
+                    if (newton3) {
+                        energyLocal += isOwnedState(owned2) ? 0.5 * upot : 0.;
+                    }
+                }
+            }
+
+            if (newton3) {
+                Kokkos::atomic_add(&soa.template operator()<Particle_T::AttributeNames::forceX, true, false>(i), fxAcc);
+                Kokkos::atomic_add(&soa.template operator()<Particle_T::AttributeNames::forceY, true, false>(i), fyAcc);
+                Kokkos::atomic_add(&soa.template operator()<Particle_T::AttributeNames::forceZ, true, false>(i), fzAcc);
+            } else {
+                soa.template operator()<Particle_T::AttributeNames::forceX, true, false>(i) += fxAcc;
+                soa.template operator()<Particle_T::AttributeNames::forceY, true, false>(i) += fyAcc;
+                soa.template operator()<Particle_T::AttributeNames::forceZ, true, false>(i) += fzAcc;
+            }
+        }, energy);
+        _potentialEnergySum += energy;
+    }
+
+    void SoAFunctorPairKokkos(const Particle_T::KokkosSoAArraysType& soa1, const Particle_T::KokkosSoAArraysType& soa2, bool /*newton3*/) final {
+        const size_t N = soa1.size();
+        const size_t M = soa2.size();
+        checkReplicaOrder<Particle_T, typename MemSpace::execution_space>(soa2, M, "FunctorKokkosGeneric");
+
+        const FloatType cutoffSquared = static_cast<FloatType>(_cutoffSquared);
+        const FloatType boxLength = static_cast<FloatType>(_boxLength);
+        const FloatType ewaldAlpha = static_cast<FloatType>(_ewaldAlpha);
+        const ParameterTable sigmaSquaredTable = _sigmaSquaredTable;
+        const ParameterTable epsilon24Table = _epsilon24Table;
+        const bool newton3 = _newton3;
+        const bool computeEnergy = _computeEnergy;
+        const bool multiType = _multiType;
+        const bool periodic = _periodic;
+        const bool coulomb = _coulomb;
+
+        double energy = 0.;
+        Kokkos::parallel_reduce(Kokkos::RangePolicy<typename MemSpace::execution_space>(0, N), KOKKOS_LAMBDA(int i, double& energyLocal) {
+
+            const auto owned1 = soa1.template operator()<Particle_T::AttributeNames::ownershipState, true, false>(i);
+
+            if (isDummyState(owned1)) {
+                return;
+            }
+
+            const auto replica1 = soa1.template operator()<Particle_T::AttributeNames::replicaId, true, false>(i);
+            const int replicaBegin = replicaBound<Particle_T, false>(soa2, static_cast<int>(M), replica1);
+            const int replicaEnd = replicaBound<Particle_T, true>(soa2, static_cast<int>(M), replica1);
+            const auto type1 = soa1.template operator()<Particle_T::AttributeNames::typeId, true, false>(i);
+            const FloatType charge1 = soa1.template operator()<Particle_T::AttributeNames::charge, true, false>(i);
+
+            FloatType fxAcc = 0.;
+            FloatType fyAcc = 0.;
+            FloatType fzAcc = 0.;
+
+            const FloatType x1 = soa1.template operator()<Particle_T::AttributeNames::posX, true, false>(i);
+            const FloatType y1 = soa1.template operator()<Particle_T::AttributeNames::posY, true, false>(i);
+            const FloatType z1 = soa1.template operator()<Particle_T::AttributeNames::posZ, true, false>(i);
+
+            for (int j = replicaBegin; j < replicaEnd; ++j) {
+                const auto owned2 = soa2.template operator()<Particle_T::AttributeNames::ownershipState, true, false>(j);
+                if (isDummyState(owned2)) {
+                    continue;
+                }
+
+                const auto type2 = soa2.template operator()<Particle_T::AttributeNames::typeId, true, false>(j);
+                const FloatType charge2 = soa2.template operator()<Particle_T::AttributeNames::charge, true, false>(j);
+
+                FloatType drX = x1 - soa2.template operator()<Particle_T::AttributeNames::posX, true, false>(j);
+                FloatType drY = y1 - soa2.template operator()<Particle_T::AttributeNames::posY, true, false>(j);
+                FloatType drZ = z1 - soa2.template operator()<Particle_T::AttributeNames::posZ, true, false>(j);
+
+                FloatType fac = 0.;
+                FloatType upot = 0.;
+                if (not computePair(drX, drY, drZ, cutoffSquared, boxLength, sigmaSquaredTable, epsilon24Table, multiType ? type1 : 0, multiType ? type2 : 0,
+                                    charge1 * charge2, ewaldAlpha, computeEnergy, periodic, coulomb, fac, upot)) {
+                    continue;
+                }
+
+                const FloatType fX = fac * drX;
+                const FloatType fY = fac * drY;
+                const FloatType fZ = fac * drZ;
+
+                fxAcc += fX;
+                fyAcc += fY;
+                fzAcc += fZ;
+
+                if (newton3) {
+                    Kokkos::atomic_sub(&soa2.template operator()<Particle_T::AttributeNames::forceX, true, false>(j), fX);
+                    Kokkos::atomic_sub(&soa2.template operator()<Particle_T::AttributeNames::forceY, true, false>(j), fY);
+                    Kokkos::atomic_sub(&soa2.template operator()<Particle_T::AttributeNames::forceZ, true, false>(j), fZ);
+                }
+
+                if (computeEnergy) {
+                    energyLocal += isOwnedState(owned1) ? 0.5 * upot : 0.;
+                    if (newton3) {
+                        energyLocal += isOwnedState(owned2) ? 0.5 * upot : 0.;
+                    }
+                }
+            }
+
+            soa1.template operator()<Particle_T::AttributeNames::forceX, true, false>(i) += fxAcc;
+            soa1.template operator()<Particle_T::AttributeNames::forceY, true, false>(i) += fyAcc;
+            soa1.template operator()<Particle_T::AttributeNames::forceZ, true, false>(i) += fzAcc;
+        }, energy);
+        _potentialEnergySum += energy;
+    }
+
+    // Reads every optional attribute, the options are only known at runtime
+    constexpr static auto getNeededAttr() {
+        return std::array<typename Particle_T::AttributeNames, 10>{
+            Particle_T::AttributeNames::posX,
+            Particle_T::AttributeNames::posY,
+            Particle_T::AttributeNames::posZ,
+            Particle_T::AttributeNames::forceX,
+            Particle_T::AttributeNames::forceY,
+            Particle_T::AttributeNames::forceZ,
+            Particle_T::AttributeNames::replicaId,
+            Particle_T::AttributeNames::ownershipState,
+            Particle_T::AttributeNames::typeId,
+            Particle_T::AttributeNames::charge,
+        };
+    }
+
+    constexpr static auto getNeededAttr(std::false_type) {
+        return std::array<typename Particle_T::AttributeNames, 7>{
+            Particle_T::AttributeNames::posX,
+            Particle_T::AttributeNames::posY,
+            Particle_T::AttributeNames::posZ,
+            Particle_T::AttributeNames::replicaId,
+            Particle_T::AttributeNames::ownershipState,
+            Particle_T::AttributeNames::typeId,
+            Particle_T::AttributeNames::charge,
+        };
+    }
+
+    constexpr static auto getComputedAttr() {
+        return std::array<typename Particle_T::AttributeNames, 3>{
+            Particle_T::AttributeNames::forceX,
+            Particle_T::AttributeNames::forceY,
+            Particle_T::AttributeNames::forceZ
+        };
+    }
+
+    /**
+     * Potential energy accumulated since the last initTraversal(), zero unless computeEnergy.
+     */
+    double getPotentialEnergy() const {
+        return _potentialEnergySum;
+    }
+
+    /**
+     * Name including the runtime options, in the format of FunctorKokkos::getVariantName().
+     */
+    std::string getVariantName() const {
+        return std::string("FunctorKokkosGeneric<Newton3=") + (_newton3 ? "1" : "0") + ",ComputeEnergy=" + (_computeEnergy ? "1" : "0")
+            + ",MultiType=" + (_multiType ? "1" : "0") + ",Periodic=" + (_periodic ? "1" : "0") + ",Coulomb=" + (_coulomb ? "1" : "0") + ">";
+    }
+
+    /* Interface required stuff */
+    std::string getName() final {
+        return "FunctorKokkosGeneric";
+    }
+
+    bool isRelevantForTuning() final {
+        return true;
+    }
+
+    bool allowsNewton3() final {
+        return _newton3;
+    }
+
+    bool allowsNonNewton3() final {
+        return not _newton3;
+    }
+
+private:
+
+    /**
+     * FunctorKokkos::computePair() with the options as arguments.
+     * @return false if the pair is outside the cutoff
+     */
+    template <class TypeIdType>
+    KOKKOS_INLINE_FUNCTION
+    static bool computePair(FloatType& drX, FloatType& drY, FloatType& drZ, FloatType cutoffSquared, FloatType boxLength,
+                            const ParameterTable& sigmaSquaredTable, const ParameterTable& epsilon24Table,
+                            TypeIdType type1, TypeIdType type2, FloatType chargeProduct, FloatType ewaldAlpha,
+                            bool computeEnergy, bool periodic, bool coulomb, FloatType& fac, FloatType& upot) {
+
+        if (periodic) {
+            drX -= boxLength * Kokkos::round(drX / boxLength);
+            drY -= boxLength * Kokkos::round(drY / boxLength);
+            drZ -= boxLength * Kokkos::round(drZ / boxLength);
+        }
+
+        const FloatType dr2 = drX * drX + drY * drY + drZ * drZ;
+
+        if (dr2 > cutoffSquared) {
+            return false;
+        }
+
+        const FloatType sigmaSquared = sigmaSquaredTable(type1, type2);
+        const FloatType epsilon24 = epsilon24Table(type1, type2);
+
+        const FloatType invDr2 = 1.0 / dr2;
+        FloatType lj6 = sigmaSquared * invDr2;
+        lj6 = lj6 * lj6 * lj6;
+        const FloatType lj12 = lj6 * lj6;
+        const FloatType lj12m6 = lj12 - lj6;
+        fac = epsilon24 * (lj12 + lj12m6) * invDr2;
+
+        if (computeEnergy) {
+            upot = epsilon24 * lj12m6 / 6.;
+        }
+
+        if (coulomb) {
+            constexpr FloatType twoOverSqrtPi = 1.1283791670955126;
+            const FloatType dr = Kokkos::sqrt(dr2);
+            const FloatType alphaDr = ewaldAlpha * dr;
+            const FloatType erfcTerm = chargeProduct * Kokkos::erfc(alphaDr) / dr;
+            fac += (erfcTerm + chargeProduct * twoOverSqrtPi * ewaldAlpha * Kokkos::exp(-alphaDr * alphaDr)) * invDr2;
+            if (computeEnergy) {
+                upot += erfcTerm;
+            }
+        }
+
+        return true;
+    }
+
+    double _cutoffSquared;
+
+    double _boxLength;
+
+    double _ewaldAlpha;
+
+    bool _newton3;
+
+    bool _computeEnergy;
+
+    bool _multiType;
+
+    bool _periodic;
+
+    bool _coulomb;
+
+    ParameterTable _sigmaSquaredTable {};
+
+    ParameterTable _epsilon24Table {};
+
+    double _potentialEnergySum {0.};
+};
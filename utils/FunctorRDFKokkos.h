@@ -0,0 +1,239 @@
+/**
+ * @file FunctorRDFKokkos.h
+ * @date 19.10.2026
+ * @author Luis Gall
+ */
+
+#pragma once
+
+#include <string>
+
+#include <Kokkos_ScatterView.hpp>
+
+#include "autopas/baseFunctors/PairwiseFunctor.h"
+#include "autopas/utils/SoAView.h"
+
+#include "KokkosParticle.h"
+
+/**
+ * Pair distance histogram for the radial distribution function, same pair loops as FunctorKokkos but without forces.
+ *
+ * Every pair within the cutoff adds one count per owned partner to its distance bin. The bins live in the memory space
+ * of the kernel and are filled through a ScatterView, only the histogram is copied to the host by the caller.
+ */
+template <class Particle_T, class MemSpace>
+class FunctorRDFKokkos : public autopas::PairwiseFunctor<Particle_T, FunctorRDFKokkos<Particle_T, MemSpace>, MemSpace> {
+
+    using Base = autopas::PairwiseFunctor<Particle_T, FunctorRDFKokkos<Particle_T, MemSpace>, MemSpace>;
+
+public:
+    using SoAArraysType = typename Particle_T::SoAArraysType;
+
+    using FloatType = typename Particle_T::ParticleSoAFloatPrecision;
+
+    using Histogram = Kokkos::View<double*, MemSpace>;
+
+    using ScatterHistogram = Kokkos::Experimental::ScatterView<double*, typename Histogram::array_layout, typename MemSpace::execution_space>;
+
+    /**
+     * @param cutoff largest sampled distance
+     * @param numBins number of equally sized distance bins in [0, cutoff)
+     * @param boxLength edge length of the cubic box for the minimum image, 0 if not periodic
+     */
+    FunctorRDFKokkos(double cutoff, size_t numBins, double boxLength)
+        : Base(cutoff),
+        _cutoffSquared{cutoff * cutoff},
+        _binsPerLength{static_cast<double>(numBins) / cutoff},
+        _boxLength{boxLength},
+        _histogram{"rdfHistogram", numBins},
+        _scatterHistogram{_histogram}
+    {}
+
+    /* Overrides for actual execution */
+    void AoSFunctor(Particle_T& i, Particle_T& j, bool newton3) final {
+
+    }
+
+    void SoAFunctorSingle(autopas::SoAView<SoAArraysType> soa, bool newton3) final {
+        // No-op as nothing should happen here
+    }
+
+    void SoAFunctorPair(autopas::SoAView<SoAArraysType> soa1, autopas::SoAView<SoAArraysType> soa2, bool newton3) final {
+        // No-op as nothing should happen here
+    }
+
+    void SoAFunctorSingleKokkos(const Particle_T::KokkosSoAArraysType& soa, bool newton3) final {
+        const size_t N = soa.size();
+        checkReplicaOrder<Particle_T, typename MemSpace::execution_space>(soa, N, "FunctorRDFKokkos");
+        const FloatType cutoffSquared = static_cast<FloatType>(_cutoffSquared);
+        const FloatType boxLength = static_cast<FloatType>(_boxLength);
+        const double binsPerLength = _binsPerLength;
+        const size_t numBins = _histogram.extent(0);
+        auto scatterHistogram = _scatterHistogram;
+
+        Kokkos::parallel_for(Kokkos::RangePolicy<typename MemSpace::execution_space>(0, N), KOKKOS_LAMBDA(int i) {
+            const auto owned1 = soa.template operator()<Particle_T::AttributeNames::ownershipState, true, false>(i);
+            if (isDummyState(owned1)) {
+                return;
+            }
+
+            const auto replica1 = soa.template operator()<Particle_T::AttributeNames::replicaId, true, false>(i);
+            const int replicaBegin = replicaBound<Particle_T, false>(soa, static_cast<int>(N), replica1);
+            const int replicaEnd = replicaBound<Particle_T, true>(soa, static_cast<int>(N), replica1);
+            const FloatType x1 = soa.template operator()<Particle_T::AttributeNames::posX, true, false>(i);
+            const FloatType y1 = soa.template operator()<Particle_T::AttributeNames::posY, true, false>(i);
+            const FloatType z1 = soa.template operator()<Particle_T::AttributeNames::posZ, true, false>(i);
+
+            auto access = scatterHistogram.access();
+
+            const auto count = [&](int j) {
+                const auto owned2 = soa.template operator()<Particle_T::AttributeNames::ownershipState, true, false>(j);
+                if (isDummyState(owned2)) {
+                    return;
+                }
+                // With newton3 the pair is visited once and counts for both partners
+                const double weight = (isOwnedState(owned1) ? 1. : 0.) + (newton3 and isOwnedState(owned2) ? 1. : 0.);
+                addPair(x1 - soa.template operator()<Particle_T::AttributeNames::posX, true, false>(j),
+                        y1 - soa.template operator()<Particle_T::AttributeNames::posY, true, false>(j),
+                        z1 - soa.template operator()<Particle_T::AttributeNames::posZ, true, false>(j),
+                        cutoffSquared, boxLength, binsPerLength, numBins, weight, access);
+            };
+
+            if (not newton3) {
+                for (int j = replicaBegin; j < i; ++j) {
+                    count(j);
+                }
+            }
+            for (int j = i + 1; j < replicaEnd; ++j) {
+                count(j);
+            }
+        });
+    }
+
+    void SoAFunctorPairKokkos(const Particle_T::KokkosSoAArraysType& soa1, const Particle_T::KokkosSoAArraysType& soa2, bool newton3) final {
+        const size_t N = soa1.size();
+        const size_t M = soa2.size();
+        checkReplicaOrder<Particle_T, typename MemSpace::execution_space>(soa2, M, "FunctorRDFKokkos");
+        const FloatType cutoffSquared = static_cast<FloatType>(_cutoffSquared);
+        const FloatType boxLength = static_cast<FloatType>(_boxLength);
+        const double binsPerLength = _binsPerLength;
+        const size_t numBins = _histogram.extent(0);
+        auto scatterHistogram = _scatterHistogram;
+
+        Kokkos::parallel_for(Kokkos::RangePolicy<typename MemSpace::execution_space>(0, N), KOKKOS_LAMBDA(int i) {
+            const auto owned1 = soa1.template operator()<Particle_T::AttributeNames::ownershipState, true, false>(i);
+            if (isDummyState(owned1)) {
+                return;
+            }
+
+            const auto replica1 = soa1.template operator()<Particle_T::AttributeNames::replicaId, true, false>(i);
+            const int replicaBegin = replicaBound<Particle_T, false>(soa2, static_cast<int>(M), replica1);
+            const int replicaEnd = replicaBound<Particle_T, true>(soa2, static_cast<int>(M), replica1);
+            const FloatType x1 = soa1.template operator()<Particle_T::AttributeNames::posX, true, false>(i);
+            const FloatType y1 = soa1.template operator()<Particle_T::AttributeNames::posY, true, false>(i);
+            const FloatType z1 = soa1.template operator()<Particle_T::AttributeNames::posZ, true, false>(i);
+
+            auto access = scatterHistogram.access();
+
+            for (int j = replicaBegin; j < replicaEnd; ++j) {
+                const auto owned2 = soa2.template operator()<Particle_T::AttributeNames::ownershipState, true, false>(j);
+                if (isDummyState(owned2)) {
+                    continue;
+                }
+                const double weight = (isOwnedState(owned1) ? 1. : 0.) + (newton3 and isOwnedState(owned2) ? 1. : 0.);
+                addPair(x1 - soa2.template operator()<Particle_T::AttributeNames::posX, true, false>(j),
+                        y1 - soa2.template operator()<Particle_T::AttributeNames::posY, true, false>(j),
+                        z1 - soa2.template operator()<Particle_T::AttributeNames::posZ, true, false>(j),
+                        cutoffSquared, boxLength, binsPerLength, numBins, weight, access);
+            }
+        });
+    }
+
+    constexpr static auto getNeededAttr() {
+        return std::array<typename Particle_T::AttributeNames, 5>{
+            Particle_T::AttributeNames::posX,
+            Particle_T::AttributeNames::posY,
+            Particle_T::AttributeNames::posZ,
+            Particle_T::AttributeNames::replicaId,
+            Particle_T::AttributeNames::ownershipState};
+    }
+
+    constexpr static auto getNeededAttr(std::false_type) {
+        return getNeededAttr();
+    }
+
+    constexpr static auto getComputedAttr() {
+        return std::array<typename Particle_T::AttributeNames, 0>{};
+    }
+
+    /**
+     * Clears the per thread copies of the ScatterView, call before computeInteractions(). Without duplication the
+     * ScatterView is the histogram itself, which therefore keeps its counts.
+     */
+    void prepare() {
+        _scatterHistogram.reset_except(_histogram);
+    }
+
+    /**
+     * Folds the per thread copies of the ScatterView into the histogram, call after computeInteractions().
+     */
+    void contribute() {
+        Kokkos::Experimental::contribute(_histogram, _scatterHistogram);
+    }
+
+    /**
+     * Pair counts per owned particle summed over all samples, in the memory space of the kernel.
+     */
+    const Histogram& getHistogram() const {
+        return _histogram;
+    }
+
+    /* Interface required stuff */
+    std::string getName() final {
+        return "FunctorRDFKokkos";
+    }
+
+    bool isRelevantForTuning() final {
+        return false;
+    }
+
+    bool allowsNewton3() final {
+        return true;
+    }
+
+    bool allowsNonNewton3() final {
+        return true;
+    }
+
+private:
+
+    template <class Access>
+    KOKKOS_INLINE_FUNCTION
+    static void addPair(FloatType drX, FloatType drY, FloatType drZ, FloatType cutoffSquared, FloatType boxLength,
+                        double binsPerLength, size_t numBins, double weight, Access& access) {
+        // Uniform over the whole launch, so this does not diverge
+        if (boxLength > 0) {
+            drX -= boxLength * Kokkos::round(drX / boxLength);
+            drY -= boxLength * Kokkos::round(drY / boxLength);
+            drZ -= boxLength * Kokkos::round(drZ / boxLength);
+        }
+
+        const FloatType dr2 = drX * drX + drY * drY + drZ * drZ;
+        if (dr2 >= cutoffSquared or weight == 0.) {
+            return;
+        }
+
+        const size_t bin = static_cast<size_t>(Kokkos::sqrt(static_cast<double>(dr2)) * binsPerLength);
+        access(bin < numBins ? bin : numBins - 1) += weight;
+    }
+
+    double _cutoffSquared;
+
+    double _binsPerLength;
+
+    double _boxLength;
+
+    Histogram _histogram;
+
+    ScatterHistogram _scatterHistogram;
+};
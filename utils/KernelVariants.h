@@ -0,0 +1,138 @@
+/**
+ * @file KernelVariants.h
+ * @date 19.10.2026
+ * @author Luis Gall
+ */
+
+#pragma once
+
+#include <string>
+#include <variant>
+
+#include "autopas/utils/ExceptionHandler.h"
+
+#include "Configuration.h"
+#include "FunctorKokkos.h"
+#include "FunctorKokkosGeneric.h"
+#include "KokkosParticle.h"
+
+/**
+ * List of the FunctorKokkos instantiations (Newton3, ComputeEnergy, MultiType, Periodic, Coulomb) that are compiled.
+ * Every entry costs one instantiation of AutoPas::computeInteractions, see computeInteractionsFunctorKokkos.cpp.
+ * Coulomb is only listed together with Periodic, as the Ewald sum assumes a periodic box.
+ */
+#ifdef AUTOPASSIMULATOR_ALL_KERNEL_VARIANTS
+#define AUTOPASSIMULATOR_KERNEL_VARIANTS_NEWTON3(X, e, mt, p, c) X(false, e, mt, p, c) X(true, e, mt, p, c)
+#define AUTOPASSIMULATOR_KERNEL_VARIANTS_ENERGY(X, mt, p, c) \
+    AUTOPASSIMULATOR_KERNEL_VARIANTS_NEWTON3(X, false, mt, p, c) AUTOPASSIMULATOR_KERNEL_VARIANTS_NEWTON3(X, true, mt, p, c)
+#define AUTOPASSIMULATOR_KERNEL_VARIANTS_MULTITYPE(X, p, c) \
+    AUTOPASSIMULATOR_KERNEL_VARIANTS_ENERGY(X, false, p, c) AUTOPASSIMULATOR_KERNEL_VARIANTS_ENERGY(X, true, p, c)
+#define AUTOPASSIMULATOR_FOR_EACH_KERNEL_VARIANT(X) \
+    AUTOPASSIMULATOR_KERNEL_VARIANTS_MULTITYPE(X, false, false) AUTOPASSIMULATOR_KERNEL_VARIANTS_MULTITYPE(X, true, false) \
+    AUTOPASSIMULATOR_KERNEL_VARIANTS_MULTITYPE(X, true, true)
+#else
+#define AUTOPASSIMULATOR_FOR_EACH_KERNEL_VARIANT(X) \
+    X(false, false, false, false, false) X(true, false, false, false, false) \
+    X(false, true, false, false, false) X(true, true, false, false, false) \
+    X(true, false, true, false, false) X(true, false, false, true, false) \
+    X(true, false, false, true, true) X(true, true, false, true, true)
+#endif
+
+// Fixed cap on the number of compiled variants, set by CMakeLists.txt. Only AUTOPASSIMULATOR_ALL_KERNEL_VARIANTS raises it
+#ifndef AUTOPASSIMULATOR_KERNEL_VARIANT_BUDGET
+#define AUTOPASSIMULATOR_KERNEL_VARIANT_BUDGET 8
+#endif
+
+namespace utils {
+
+#define AUTOPASSIMULATOR_KERNEL_VARIANT_TYPE(newton3, energy, multiType, periodic, coulomb) , FunctorKokkos<ParticleType, MemSpace, newton3, energy, multiType, periodic, coulomb>
+
+    /**
+     * Holds the one FunctorKokkos instantiation chosen at startup, std::monostate until then.
+     */
+    template <class MemSpace>
+    using KernelVariant = std::variant<std::monostate AUTOPASSIMULATOR_FOR_EACH_KERNEL_VARIANT(AUTOPASSIMULATOR_KERNEL_VARIANT_TYPE)>;
+
+#undef AUTOPASSIMULATOR_KERNEL_VARIANT_TYPE
+
+    static_assert(std::variant_size_v<KernelVariant<Kokkos::HostSpace>> - 1 <= AUTOPASSIMULATOR_KERNEL_VARIANT_BUDGET,
+                  "More FunctorKokkos variants than AUTOPASSIMULATOR_KERNEL_VARIANT_BUDGET allows, shorten the selection or raise the budget");
+
+    class KernelVariants {
+    public:
+        /**
+         * Picks the instantiation matching the configuration. Throws if that combination is not compiled.
+         */
+        template <class MemSpace>
+        static KernelVariant<MemSpace> choose(const Configuration& config) {
+            const bool newton3 = config.getNewton3();
+            const bool energy = config.getComputeEnergy();
+            const bool multiType = config.getNumTypes() > 1;
+            const bool periodic = config.getPeriodic();
+            const bool coulomb = config.getSpme();
+
+            KernelVariant<MemSpace> chosen {};
+
+#define AUTOPASSIMULATOR_KERNEL_VARIANT_CHOOSE(n3, e, mt, p, c)                                               \
+            if (newton3 == n3 and energy == e and multiType == mt and periodic == p and coulomb == c) {      \
+                chosen.template emplace<FunctorKokkos<ParticleType, MemSpace, n3, e, mt, p, c>>(             \
+                    config.getCutoff(), config.getBoxMax() - config.getBoxMin(), config.getEpsilons(), config.getSigmas(), config.getEwaldAlpha()); \
+            }
+
+            AUTOPASSIMULATOR_FOR_EACH_KERNEL_VARIANT(AUTOPASSIMULATOR_KERNEL_VARIANT_CHOOSE)
+
+#undef AUTOPASSIMULATOR_KERNEL_VARIANT_CHOOSE
+
+            if (std::holds_alternative<std::monostate>(chosen)) {
+                autopas::utils::ExceptionHandler::exception(
+                    "KernelVariants: FunctorKokkos<Newton3={}, ComputeEnergy={}, MultiType={}, Periodic={}, Coulomb={}> is not compiled, "
+                    "configure with AUTOPASSIMULATOR_ALL_KERNEL_VARIANTS=ON (raises the variant budget to 24)", newton3, energy, multiType, periodic, coulomb);
+            }
+            return chosen;
+        }
+
+        /**
+         * Calls f with every compiled variant that can run with the given newton3 setting.
+         */
+        template <class MemSpace, class FunctionType>
+        static void forEachCompatible(const Configuration& config, FunctionType f) {
+
+#define AUTOPASSIMULATOR_KERNEL_VARIANT_APPLY(n3, e, mt, p, c)                                                \
+            if (config.getNewton3() == n3) {                                                                 \
+                f(FunctorKokkos<ParticleType, MemSpace, n3, e, mt, p, c>(                                    \
+                    config.getCutoff(), config.getBoxMax() - config.getBoxMin(), config.getEpsilons(), config.getSigmas(), config.getEwaldAlpha())); \
+            }
+
+            AUTOPASSIMULATOR_FOR_EACH_KERNEL_VARIANT(AUTOPASSIMULATOR_KERNEL_VARIANT_APPLY)
+
+#undef AUTOPASSIMULATOR_KERNEL_VARIANT_APPLY
+        }
+
+        /**
+         * Runtime-branch kernel with the options of the configuration, the baseline of the specialized variants.
+         */
+        template <class MemSpace>
+        static FunctorKokkosGeneric<ParticleType, MemSpace> generic(const Configuration& config) {
+            return FunctorKokkosGeneric<ParticleType, MemSpace>(config.getCutoff(), config.getBoxMax() - config.getBoxMin(), config.getEpsilons(), config.getSigmas(),
+                config.getEwaldAlpha(), config.getNewton3(), config.getComputeEnergy(), config.getNumTypes() > 1, config.getPeriodic(), config.getSpme());
+        }
+
+        /**
+         * Calls f with the functor held by variant.
+         */
+        template <class ReturnType, class MemSpace, class FunctionType>
+        static ReturnType apply(KernelVariant<MemSpace>& variant, FunctionType f) {
+            return std::visit([&](auto& functor) -> ReturnType {
+                if constexpr (std::is_same_v<std::decay_t<decltype(functor)>, std::monostate>) {
+                    autopas::utils::ExceptionHandler::exception("KernelVariants: no FunctorKokkos variant chosen");
+                    if constexpr (not std::is_void_v<ReturnType>) {
+                        return ReturnType{};
+                    }
+                } else {
+                    return f(functor);
+                }
+            }, variant);
+        }
+    };
+
+}
@@ -5,12 +5,91 @@
  */
 
 #pragma once
+
+#include <cstdint>
+
+#include <Kokkos_Core.hpp>
+
 #include "autopas/particles/ParticleDefinitions.h"
+#include "autopas/utils/ExceptionHandler.h"
+
+/**
+ * One byte replacement for autopas::OwnershipState, values match the AutoPas ones.
+ */
+enum class CompactOwnershipState : uint8_t {
+    dummy = static_cast<uint8_t>(autopas::OwnershipState::dummy),
+    owned = static_cast<uint8_t>(autopas::OwnershipState::owned),
+    halo = static_cast<uint8_t>(autopas::OwnershipState::halo)
+};
+
+/**
+ * Ownership checks usable with both autopas::OwnershipState and CompactOwnershipState SoA entries.
+ */
+template <class OwnershipType>
+KOKKOS_INLINE_FUNCTION constexpr bool isDummyState(OwnershipType state) {
+    return static_cast<autopas::OwnershipState>(state) == autopas::OwnershipState::dummy;
+}
+
+template <class OwnershipType>
+KOKKOS_INLINE_FUNCTION constexpr bool isOwnedState(OwnershipType state) {
+    return static_cast<autopas::OwnershipState>(state) == autopas::OwnershipState::owned;
+}
+
+/**
+ * Replicas occupy contiguous slices of every SoA, sorted by replica id (see Setup::fillParticles), so the partners of a
+ * particle are found by binary search instead of filtering all pairs of the SoA.
+ * @return first index in [0, size) whose replica id is not less than (Upper: greater than) replica
+ */
+template <class Particle_T, bool Upper, class SoA, class ReplicaType>
+KOKKOS_INLINE_FUNCTION int replicaBound(const SoA& soa, int size, ReplicaType replica) {
+    int low = 0;
+    int high = size;
+    while (low < high) {
+        const int mid = low + (high - low) / 2;
+        const auto midReplica = soa.template operator()<Particle_T::AttributeNames::replicaId, true, false>(mid);
+        if (Upper ? midReplica <= replica : midReplica < replica) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
 
-class KokkosParticle {
+/**
+ * Throws if the replica ids of the first size entries of soa are not sorted, e.g. after a container reordered its
+ * particles. replicaBound() would then silently miss partners outside the found slice. The check is one reduction per
+ * kernel call and therefore only compiled without NDEBUG.
+ */
+template <class Particle_T, class ExecutionSpace, class SoA>
+void checkReplicaOrder(const SoA& soa, size_t size, const char* functorName) {
+#ifndef NDEBUG
+    size_t descents = 0;
+    Kokkos::parallel_reduce("checkReplicaOrder", Kokkos::RangePolicy<ExecutionSpace>(1, size > 1 ? size : 1), KOKKOS_LAMBDA(int i, size_t& local) {
+        if (soa.template operator()<Particle_T::AttributeNames::replicaId, true, false>(i)
+            < soa.template operator()<Particle_T::AttributeNames::replicaId, true, false>(i - 1)) {
+            ++local;
+        }
+    }, descents);
+    if (descents > 0) {
+        autopas::utils::ExceptionHandler::exception("{}: replica ids of the SoA are not sorted ({} descents), the replica slices would miss interactions",
+                                                    functorName, descents);
+    }
+#endif
+}
+
+/**
+ * Particle for the Kokkos SoA path, the integer columns are configurable to reduce the bytes per particle.
+ * @tparam IdType type of the particle id
+ * @tparam TypeIdType type of the particle type id
+ * @tparam ReplicaIdType type of the replica id
+ * @tparam OwnershipType autopas::OwnershipState or CompactOwnershipState
+ */
+template <class IdType, class TypeIdType, class ReplicaIdType, class OwnershipType>
+class BasicKokkosParticle {
 
 public:
-    KokkosParticle() = default;
+    BasicKokkosParticle() = default;
 
     using ParticleSoAFloatPrecision = float;
 
@@ -34,21 +113,38 @@ public:
         oldForceZ,
         typeId,
         mass,
+        charge,
+        replicaId,
         ownershipState
       };
 
-    using KokkosSoAArraysType = autopas::utils::KokkosSoA<size_t* /*id*/, ParticleSoAFloatPrecision* /*x*/, ParticleSoAFloatPrecision* /*y*/, ParticleSoAFloatPrecision* /*z*/,
+    using KokkosSoAArraysType = autopas::utils::KokkosSoA<IdType* /*id*/, ParticleSoAFloatPrecision* /*x*/, ParticleSoAFloatPrecision* /*y*/, ParticleSoAFloatPrecision* /*z*/,
                                        ParticleSoAFloatPrecision* /*rebuildX*/, ParticleSoAFloatPrecision* /*rebuildY*/, ParticleSoAFloatPrecision* /*rebuildZ*/,
                                        ParticleSoAFloatPrecision* /*vx*/, ParticleSoAFloatPrecision* /*vy*/, ParticleSoAFloatPrecision* /*vz*/, ParticleSoAFloatPrecision* /*fx*/, ParticleSoAFloatPrecision* /*fy*/,
                                        ParticleSoAFloatPrecision* /*fz*/, ParticleSoAFloatPrecision* /*oldFx*/, ParticleSoAFloatPrecision* /*oldFy*/, ParticleSoAFloatPrecision* /*oldFz*/,
-                                       size_t* /*typeid*/, ParticleSoAFloatPrecision* /*mass*/, autopas::OwnershipState* /*ownershipState*/>;
+                                       TypeIdType* /*typeid*/, ParticleSoAFloatPrecision* /*mass*/, ParticleSoAFloatPrecision* /*charge*/, ReplicaIdType* /*replicaId*/, OwnershipType* /*ownershipState*/>;
 
     using SoAArraysType =
-      autopas::utils::SoAType<KokkosParticle *, size_t /*id*/, ParticleSoAFloatPrecision /*x*/, ParticleSoAFloatPrecision /*y*/, ParticleSoAFloatPrecision /*z*/,
+      autopas::utils::SoAType<BasicKokkosParticle *, IdType /*id*/, ParticleSoAFloatPrecision /*x*/, ParticleSoAFloatPrecision /*y*/, ParticleSoAFloatPrecision /*z*/,
                                        ParticleSoAFloatPrecision /*rebuildX*/, ParticleSoAFloatPrecision /*rebuildY*/, ParticleSoAFloatPrecision /*rebuildZ*/,
                                        ParticleSoAFloatPrecision /*vx*/, ParticleSoAFloatPrecision /*vy*/, ParticleSoAFloatPrecision /*vz*/, ParticleSoAFloatPrecision /*fx*/, ParticleSoAFloatPrecision /*fy*/,
                                        ParticleSoAFloatPrecision /*fz*/, ParticleSoAFloatPrecision /*oldFx*/, ParticleSoAFloatPrecision /*oldFy*/, ParticleSoAFloatPrecision /*oldFz*/,
-                                       size_t /*typeid*/, ParticleSoAFloatPrecision /*mass*/, autopas::OwnershipState /*ownershipState*/>::Type;
+                                       TypeIdType /*typeid*/, ParticleSoAFloatPrecision /*mass*/, ParticleSoAFloatPrecision /*charge*/, ReplicaIdType /*replicaId*/, OwnershipType /*ownershipState*/>::Type;
+
+    using IdStorageType = IdType;
+
+    using TypeIdStorageType = TypeIdType;
+
+    using ReplicaIdStorageType = ReplicaIdType;
+
+    /**
+     * Bytes of all SoA columns of one particle, i.e. everything but the ptr attribute.
+     */
+    constexpr static size_t getBytesPerParticle() {
+        return []<size_t... attributes>(std::index_sequence<attributes...>) {
+            return (sizeof(typename std::tuple_element<attributes + 1, SoAArraysType>::type::value_type) + ...);
+        }(std::make_index_sequence<std::tuple_size_v<SoAArraysType> - 1>{});
+    }
 
     template <AttributeNames attribute>
     constexpr auto& operator() () {
@@ -56,12 +152,12 @@ public:
     }
 
     template <AttributeNames attribute, std::enable_if_t<attribute == ptr, bool> = true>
-    constexpr std::tuple_element<attribute, SoAArraysType>::type::value_type get() {
+    constexpr typename std::tuple_element<attribute, SoAArraysType>::type::value_type get() {
         return this;
     }
 
     template <AttributeNames attribute, std::enable_if_t<attribute != ptr, bool> = true>
-    constexpr std::tuple_element<attribute, SoAArraysType>::type::value_type& get() {
+    constexpr typename std::tuple_element<attribute, SoAArraysType>::type::value_type& get() {
         if constexpr (attribute == id) {
             return _id;
         } else if constexpr (attribute == posX) {
@@ -98,6 +194,10 @@ public:
             return _typeId;
         } else if constexpr (attribute == mass) {
             return _mass;
+        } else if constexpr (attribute == charge) {
+            return _charge;
+        } else if constexpr (attribute == replicaId) {
+            return _replicaId;
         } else if constexpr (attribute == ownershipState) {
             return _state;
         } else {
@@ -106,7 +206,7 @@ public:
     }
 
     template <AttributeNames attribute, std::enable_if_t<attribute != ptr, bool> = true>
-    constexpr std::tuple_element<attribute, SoAArraysType>::type::value_type get() const {
+    constexpr typename std::tuple_element<attribute, SoAArraysType>::type::value_type get() const {
         if constexpr (attribute == id) {
             return _id;
         } else if constexpr (attribute == posX) {
@@ -143,6 +243,10 @@ public:
             return _typeId;
         } else if constexpr (attribute == mass) {
             return _mass;
+        } else if constexpr (attribute == charge) {
+            return _charge;
+        } else if constexpr (attribute == replicaId) {
+            return _replicaId;
         } else if constexpr (attribute == ownershipState) {
             return _state;
         } else {
@@ -151,7 +255,7 @@ public:
     }
 
     template <AttributeNames attribute>
-    constexpr void set(std::tuple_element<attribute, SoAArraysType>::type::value_type value) {
+    constexpr void set(typename std::tuple_element<attribute, SoAArraysType>::type::value_type value) {
         if constexpr (attribute == id) {
             _id = value;
         } else if constexpr (attribute == posX) {
@@ -188,6 +292,10 @@ public:
             _typeId = value;
         } else if constexpr (attribute == mass) {
             _mass = value;
+        } else if constexpr (attribute == charge) {
+            _charge = value;
+        } else if constexpr (attribute == replicaId) {
+            _replicaId = value;
         } else if constexpr (attribute == ownershipState) {
            _state = value;
         } else {
@@ -226,19 +334,43 @@ public:
     }
 
     void setID(const size_t id) {
-        _id = id;
+        _id = static_cast<IdType>(id);
     }
 
     void setMass(ParticleSoAFloatPrecision mass) {
         _mass = mass;
     }
 
+    ParticleSoAFloatPrecision getCharge() const {
+        return _charge;
+    }
+
+    void setCharge(ParticleSoAFloatPrecision charge) {
+        _charge = charge;
+    }
+
+    size_t getTypeId() const {
+        return _typeId;
+    }
+
+    void setTypeId(const size_t typeId) {
+        _typeId = static_cast<TypeIdType>(typeId);
+    }
+
+    size_t getReplicaId() const {
+        return _replicaId;
+    }
+
+    void setReplicaId(const size_t replicaId) {
+        _replicaId = static_cast<ReplicaIdType>(replicaId);
+    }
+
     autopas::OwnershipState getOwnershipState() const {
-        return _state;
+        return static_cast<autopas::OwnershipState>(_state);
     }
 
     void setOwnershipState(autopas::OwnershipState newState) {
-        _state = newState;
+        _state = static_cast<OwnershipType>(newState);
     }
 
     std::array<ParticleSoAFloatPrecision, 3> calculateDisplacementSinceRebuild() const {
@@ -286,10 +418,33 @@ private:
 
     ParticleSoAFloatPrecision _mass = 0.;
 
-    size_t _id = 0;
+    ParticleSoAFloatPrecision _charge = 0.;
+
+    IdType _id = 0;
+
+    TypeIdType _typeId = 0;
 
-    size_t _typeId = 0;
+    ReplicaIdType _replicaId = 0;
 
-    autopas::OwnershipState _state {};
+    OwnershipType _state {};
 
 };
+
+/**
+ * Default layout. The replica id is 16 bit as well, more replicas are rejected by Setup::fillParticles.
+ */
+using KokkosParticle = BasicKokkosParticle<size_t, size_t, uint16_t, autopas::OwnershipState>;
+
+/**
+ * 32 bit ids, 8 bit type ids, 16 bit replica ids and a one byte ownership state.
+ */
+using CompactKokkosParticle = BasicKokkosParticle<uint32_t, uint8_t, uint16_t, CompactOwnershipState>;
+
+/**
+ * Particle type the simulator is compiled for, see AUTOPASSIMULATOR_COMPACT_PARTICLE.
+ */
+#ifdef AUTOPASSIMULATOR_COMPACT_PARTICLE
+using ParticleType = CompactKokkosParticle;
+#else
+using ParticleType = KokkosParticle;
+#endif
@@ -0,0 +1,82 @@
+/**
+ * @file LaunchCounter.h
+ * @date 19.10.2026
+ * @author Luis Gall
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+
+#include <Kokkos_Core.hpp>
+
+namespace utils {
+
+    /**
+     * Counts the parallel_for, parallel_reduce and parallel_scan launches while alive through the Kokkos Tools
+     * callbacks, including the ones inside AutoPas.
+     *
+     * The callbacks are shared with profiling tools, so nothing is counted if a tool library is loaded.
+     */
+    class LaunchCounter {
+    public:
+        LaunchCounter()
+            : _enabled{not Kokkos::Tools::profileLibraryLoaded()}
+        {
+            if (_enabled) {
+                _launches = 0;
+                _counting = true;
+                Kokkos::Tools::Experimental::set_begin_parallel_for_callback(count);
+                Kokkos::Tools::Experimental::set_begin_parallel_reduce_callback(count);
+                Kokkos::Tools::Experimental::set_begin_parallel_scan_callback(count);
+            }
+        }
+
+        ~LaunchCounter() {
+            if (_enabled) {
+                Kokkos::Tools::Experimental::set_begin_parallel_for_callback(nullptr);
+                Kokkos::Tools::Experimental::set_begin_parallel_reduce_callback(nullptr);
+                Kokkos::Tools::Experimental::set_begin_parallel_scan_callback(nullptr);
+            }
+        }
+
+        LaunchCounter(const LaunchCounter&) = delete;
+
+        LaunchCounter& operator=(const LaunchCounter&) = delete;
+
+        /**
+         * Launches in between suspend() and resume() are not counted, e.g. the snapshots of the validation.
+         */
+        void suspend() {
+            _counting = false;
+        }
+
+        void resume() {
+            _counting = true;
+        }
+
+        /**
+         * Counted launches, empty if a tool library is loaded.
+         */
+        std::optional<size_t> getLaunches() const {
+            return _enabled ? std::optional<size_t>{_launches.load()} : std::nullopt;
+        }
+
+    private:
+
+        static void count(const char*, uint32_t, uint64_t*) {
+            if (_counting) {
+                ++_launches;
+            }
+        }
+
+        static inline std::atomic<size_t> _launches {0};
+
+        static inline std::atomic<bool> _counting {false};
+
+        bool _enabled;
+    };
+
+}
@@ -0,0 +1,100 @@
+/**
+ * @file RunRecord.h
+ * @date 19.10.2026
+ * @author Luis Gall
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace utils {
+
+    /**
+     * Results of one simulation run, written as one JSON object per line in batch mode.
+     */
+    struct RunRecord {
+        size_t run {0};
+
+        // Arguments of the batch line, on top of the command line
+        std::vector<std::string> arguments {};
+
+        // Whether the AutoPas instance of the previous run was reused instead of constructing a new one
+        bool reusedInstance {false};
+
+        std::string kernel {};
+
+        size_t numParticles {0};
+
+        size_t iterations {0};
+
+        // ns
+        uint64_t totalTime {0};
+
+        // Particle steps per second
+        double throughput {0.};
+
+        std::optional<double> potentialEnergy {};
+
+        std::optional<bool> validationPassed {};
+
+        // Message of the exception that aborted the run, the other results are incomplete then
+        std::optional<std::string> error {};
+
+        // Force computation of numReplicas single replica instances over one of the ensemble, see --replicaBaseline
+        std::optional<double> replicaSpeedup {};
+
+        // Force computation with the pairwise and triwise kernel over one with the pairwise kernel only, see --triwiseBaseline
+        std::optional<double> triwiseCost {};
+
+        std::string toJson() const {
+            std::ostringstream json;
+            json << "{\"run\":" << run << ",\"arguments\":[";
+            for (size_t i = 0; i < arguments.size(); ++i) {
+                json << (i > 0 ? "," : "") << quote(arguments[i]);
+            }
+            json << "],\"reusedInstance\":" << (reusedInstance ? "true" : "false")
+                 << ",\"kernel\":" << quote(kernel)
+                 << ",\"numParticles\":" << numParticles
+                 << ",\"iterations\":" << iterations
+                 << ",\"totalTimeNs\":" << totalTime
+                 << ",\"meanStepNs\":" << (iterations > 0 ? totalTime / iterations : 0)
+                 << ",\"throughput\":" << throughput;
+            if (potentialEnergy) {
+                json << ",\"potentialEnergy\":" << *potentialEnergy;
+            }
+            if (validationPassed) {
+                json << ",\"validationPassed\":" << (*validationPassed ? "true" : "false");
+            }
+            if (replicaSpeedup) {
+                json << ",\"replicaSpeedup\":" << *replicaSpeedup;
+            }
+            if (triwiseCost) {
+                json << ",\"triwiseCost\":" << *triwiseCost;
+            }
+            if (error) {
+                json << ",\"error\":" << quote(*error);
+            }
+            json << "}";
+            return json.str();
+        }
+
+    private:
+
+        static std::string quote(const std::string& value) {
+            std::string quoted = "\"";
+            for (const char c : value) {
+                if (c == '"' or c == '\\') {
+                    quoted += '\\';
+                }
+                quoted += c;
+            }
+            return quoted + "\"";
+        }
+    };
+
+}
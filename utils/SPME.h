@@ -0,0 +1,330 @@
+/**
+ * @file SPME.h
+ * @date 19.10.2026
+ * @author Luis Gall
+ */
+
+#pragma once
+
+#include <cmath>
+#include <iostream>
+#include <numbers>
+#include <vector>
+
+#include <Kokkos_ScatterView.hpp>
+
+#include "autopas/utils/ExceptionHandler.h"
+#include "autopas/utils/Timer.h"
+
+#include "FFT.h"
+#include "KokkosParticle.h"
+
+namespace utils {
+
+    /**
+     * Reciprocal-space part of the Ewald sum with smooth particle-mesh Ewald (Essmann et al. 1995), CPU only.
+     *
+     * The real-space part is computed by FunctorKokkos with Coulomb = true using the same alpha. Accuracy is controlled
+     * by the grid size, the spline order and alpha: a larger alpha moves work from the pair kernel to the grid.
+     */
+    class SPME {
+    public:
+        static constexpr size_t maxSplineOrder = 10;
+
+        using RealGrid = Kokkos::View<double***, Kokkos::LayoutRight, Kokkos::HostSpace>;
+
+        using ScatterGrid = Kokkos::Experimental::ScatterView<double***, Kokkos::LayoutRight, Kokkos::DefaultHostExecutionSpace>;
+
+        /**
+         * @param gridSize grid points per dimension, power of two
+         * @param splineOrder B-spline order, between 3 and maxSplineOrder
+         * @param alpha Ewald splitting parameter
+         * @param boxMin lower corner of the cubic periodic box
+         * @param boxLength edge length of the box
+         */
+        SPME(size_t gridSize, size_t splineOrder, double alpha, double boxMin, double boxLength)
+            : _gridSize{gridSize}, _splineOrder{splineOrder}, _alpha{alpha}, _boxMin{boxMin}, _boxLength{boxLength} {
+
+            if (not fft::isPowerOfTwo(gridSize)) {
+                autopas::utils::ExceptionHandler::exception("SPME: grid size {} is not a power of two", gridSize);
+            }
+            if (splineOrder < 3 or splineOrder > maxSplineOrder or splineOrder > gridSize) {
+                autopas::utils::ExceptionHandler::exception("SPME: spline order {} not in [3, {}]", splineOrder, maxSplineOrder);
+            }
+
+            _chargeGrid = RealGrid("spmeChargeGrid", gridSize, gridSize, gridSize);
+            _potentialGrid = RealGrid("spmePotentialGrid", gridSize, gridSize, gridSize);
+            _influence = RealGrid("spmeInfluence", gridSize, gridSize, gridSize);
+            _transformGrid = fft::Grid("spmeTransformGrid", gridSize, gridSize, gridSize);
+            _scatterGrid = ScatterGrid(_chargeGrid);
+
+            computeInfluenceFunction();
+        }
+
+        /**
+         * Adds the reciprocal-space forces to all owned particles.
+         * @return reciprocal-space energy
+         */
+        template <class Container>
+        double computeForces(Container& autopasInstance) {
+            const size_t gridSize = _gridSize;
+            const size_t order = _splineOrder;
+            const double boxMin = _boxMin;
+            const double gridPerLength = static_cast<double>(gridSize) / _boxLength;
+
+            // 1. Spread the charges onto the grid
+            _spreadTimer.start();
+            Kokkos::deep_copy(_chargeGrid, 0.);
+            _scatterGrid.reset();
+            auto scatterGrid = _scatterGrid;
+            autopasInstance.template forEachKokkos<Kokkos::DefaultHostExecutionSpace>([=](int i, const autopas::utils::KokkosStorage<ParticleType>& storage) {
+                const double charge = storage.template operator()<ParticleType::AttributeNames::charge, true, true>(i);
+                if (charge == 0.) {
+                    return;
+                }
+
+                double theta[3][maxSplineOrder];
+                double dTheta[3][maxSplineOrder];
+                int firstIndex[3];
+                fillParticleSplines(storage.template operator()<ParticleType::AttributeNames::posX, true, true>(i), 0, boxMin, gridPerLength, gridSize, order, theta, dTheta, firstIndex);
+                fillParticleSplines(storage.template operator()<ParticleType::AttributeNames::posY, true, true>(i), 1, boxMin, gridPerLength, gridSize, order, theta, dTheta, firstIndex);
+                fillParticleSplines(storage.template operator()<ParticleType::AttributeNames::posZ, true, true>(i), 2, boxMin, gridPerLength, gridSize, order, theta, dTheta, firstIndex);
+
+                auto access = scatterGrid.access();
+                for (size_t a = 0; a < order; ++a) {
+                    const size_t ia = (firstIndex[0] + a) % gridSize;
+                    for (size_t b = 0; b < order; ++b) {
+                        const size_t ib = (firstIndex[1] + b) % gridSize;
+                        const double weightAB = charge * theta[0][a] * theta[1][b];
+                        for (size_t c = 0; c < order; ++c) {
+                            access(ia, ib, (firstIndex[2] + c) % gridSize) += weightAB * theta[2][c];
+                        }
+                    }
+                }
+            }, autopas::IteratorBehavior::owned);
+            Kokkos::Experimental::contribute(_chargeGrid, _scatterGrid);
+            Kokkos::fence();
+            _spreadTimer.stop();
+
+            // 2. Forward transform of the charge grid
+            _forwardFFTTimer.start();
+            const auto chargeGrid = _chargeGrid;
+            const auto transformGrid = _transformGrid;
+            const auto influence = _influence;
+            const auto potentialGrid = _potentialGrid;
+            using GridPolicy = Kokkos::MDRangePolicy<Kokkos::DefaultHostExecutionSpace, Kokkos::Rank<3>>;
+            const GridPolicy gridPolicy ({0, 0, 0}, {gridSize, gridSize, gridSize});
+            Kokkos::parallel_for("spmeLoadGrid", gridPolicy, [=](const size_t a, const size_t b, const size_t c) {
+                transformGrid(a, b, c) = fft::Complex(chargeGrid(a, b, c), 0.);
+            });
+            fft::fft3d(transformGrid, false);
+            _forwardFFTTimer.stop();
+
+            // 3. Convolution with the influence function, the energy is 1/2 sum G(m) |Q(m)|^2
+            _convolutionTimer.start();
+            double energy = 0.;
+            Kokkos::parallel_reduce("spmeConvolution", gridPolicy, [=](const size_t a, const size_t b, const size_t c, double& energyLocal) {
+                const fft::Complex value = transformGrid(a, b, c);
+                energyLocal += 0.5 * influence(a, b, c) * (value.real() * value.real() + value.imag() * value.imag());
+                transformGrid(a, b, c) = value * influence(a, b, c);
+            }, energy);
+            _convolutionTimer.stop();
+
+            // 4. Backward transform gives dE/dQ on the grid
+            _backwardFFTTimer.start();
+            fft::fft3d(transformGrid, true);
+            Kokkos::parallel_for("spmeStoreGrid", gridPolicy, [=](const size_t a, const size_t b, const size_t c) {
+                potentialGrid(a, b, c) = transformGrid(a, b, c).real();
+            });
+            Kokkos::fence();
+            _backwardFFTTimer.stop();
+
+            // 5. Interpolate the forces back to the particles
+            _interpolationTimer.start();
+            autopasInstance.template forEachKokkos<Kokkos::DefaultHostExecutionSpace>([=](int i, const autopas::utils::KokkosStorage<ParticleType>& storage) {
+                const double charge = storage.template operator()<ParticleType::AttributeNames::charge, true, true>(i);
+                if (charge == 0.) {
+                    return;
+                }
+
+                double theta[3][maxSplineOrder];
+                double dTheta[3][maxSplineOrder];
+                int firstIndex[3];
+                fillParticleSplines(storage.template operator()<ParticleType::AttributeNames::posX, true, true>(i), 0, boxMin, gridPerLength, gridSize, order, theta, dTheta, firstIndex);
+                fillParticleSplines(storage.template operator()<ParticleType::AttributeNames::posY, true, true>(i), 1, boxMin, gridPerLength, gridSize, order, theta, dTheta, firstIndex);
+                fillParticleSplines(storage.template operator()<ParticleType::AttributeNames::posZ, true, true>(i), 2, boxMin, gridPerLength, gridSize, order, theta, dTheta, firstIndex);
+
+                double gradX = 0.;
+                double gradY = 0.;
+                double gradZ = 0.;
+                for (size_t a = 0; a < order; ++a) {
+                    const size_t ia = (firstIndex[0] + a) % gridSize;
+                    for (size_t b = 0; b < order; ++b) {
+                        const size_t ib = (firstIndex[1] + b) % gridSize;
+                        for (size_t c = 0; c < order; ++c) {
+                            const double potential = potentialGrid(ia, ib, (firstIndex[2] + c) % gridSize);
+                            gradX += dTheta[0][a] * theta[1][b] * theta[2][c] * potential;
+                            gradY += theta[0][a] * dTheta[1][b] * theta[2][c] * potential;
+                            gradZ += theta[0][a] * theta[1][b] * dTheta[2][c] * potential;
+                        }
+                    }
+                }
+
+                storage.template operator()<ParticleType::AttributeNames::forceX, true, true>(i) -= charge * gridPerLength * gradX;
+                storage.template operator()<ParticleType::AttributeNames::forceY, true, true>(i) -= charge * gridPerLength * gradY;
+                storage.template operator()<ParticleType::AttributeNames::forceZ, true, true>(i) -= charge * gridPerLength * gradZ;
+            }, autopas::IteratorBehavior::owned);
+            Kokkos::fence();
+            _interpolationTimer.stop();
+
+            return energy;
+        }
+
+        /**
+         * Constant self-interaction correction -alpha / sqrt(pi) * sum q_i^2 of the Ewald sum.
+         */
+        template <class Container>
+        double computeSelfEnergy(Container& autopasInstance) const {
+            double sumChargeSquared = 0.;
+            autopasInstance.template reduceKokkos<Kokkos::DefaultHostExecutionSpace, double, Kokkos::Sum<double>>([=](int i, const autopas::utils::KokkosStorage<ParticleType>& storage, double& local) {
+                const double charge = storage.template operator()<ParticleType::AttributeNames::charge, true, true>(i);
+                local += charge * charge;
+            }, sumChargeSquared, autopas::IteratorBehavior::owned);
+            return -_alpha / std::sqrt(std::numbers::pi) * sumChargeSquared;
+        }
+
+        void printTimers(std::ostream& out) const {
+            out << "SPME spreading: " << _spreadTimer.getTotalTime() << std::endl;
+            out << "SPME forward FFT: " << _forwardFFTTimer.getTotalTime() << std::endl;
+            out << "SPME convolution: " << _convolutionTimer.getTotalTime() << std::endl;
+            out << "SPME backward FFT: " << _backwardFFTTimer.getTotalTime() << std::endl;
+            out << "SPME interpolation: " << _interpolationTimer.getTotalTime() << std::endl;
+        }
+
+    private:
+
+        /**
+         * Cardinal B-spline weights of order n at the fractional offset w (Essmann et al., appendix). theta[t] belongs to
+         * the grid point floor(u) - n + 1 + t.
+         */
+        static void fillBSpline(double w, size_t n, double* theta, double* dTheta) {
+            theta[n - 1] = 0.;
+            theta[1] = w;
+            theta[0] = 1. - w;
+            for (size_t k = 3; k <= n - 1; ++k) {
+                const double div = 1. / static_cast<double>(k - 1);
+                theta[k - 1] = div * w * theta[k - 2];
+                for (size_t j = 1; j <= k - 2; ++j) {
+                    theta[k - j - 1] = div * ((w + j) * theta[k - j - 2] + (k - j - w) * theta[k - j - 1]);
+                }
+                theta[0] = div * (1. - w) * theta[0];
+            }
+
+            // Derivatives from the order n - 1 weights
+            dTheta[0] = -theta[0];
+            for (size_t j = 1; j < n; ++j) {
+                dTheta[j] = theta[j - 1] - theta[j];
+            }
+
+            const double div = 1. / static_cast<double>(n - 1);
+            theta[n - 1] = div * w * theta[n - 2];
+            for (size_t j = 1; j <= n - 2; ++j) {
+                theta[n - j - 1] = div * ((w + j) * theta[n - j - 2] + (n - j - w) * theta[n - j - 1]);
+            }
+            theta[0] = div * (1. - w) * theta[0];
+        }
+
+        static void fillParticleSplines(double position, int dim, double boxMin, double gridPerLength, size_t gridSize, size_t order,
+                                        double (&theta)[3][maxSplineOrder], double (&dTheta)[3][maxSplineOrder], int (&firstIndex)[3]) {
+            // Scaled fractional coordinate, wrapped into [0, gridSize) for particles that left the box
+            double u = (position - boxMin) * gridPerLength;
+            u -= static_cast<double>(gridSize) * std::floor(u / static_cast<double>(gridSize));
+            const double cell = std::floor(u);
+
+            fillBSpline(u - cell, order, theta[dim], dTheta[dim]);
+            firstIndex[dim] = static_cast<int>(cell) - static_cast<int>(order) + 1 + static_cast<int>(gridSize);
+        }
+
+        /**
+         * G(m) = exp(-pi^2 m^2 / alpha^2) / (pi V m^2) * B(m), with the B-spline moduli B(m) and G(0) = 0.
+         */
+        void computeInfluenceFunction() {
+            const size_t gridSize = _gridSize;
+
+            // |b(m)|^-2 is the same in every dimension of the cubic grid
+            std::vector<double> theta (_splineOrder);
+            std::vector<double> dTheta (_splineOrder);
+            fillBSpline(0., _splineOrder, theta.data(), dTheta.data());
+
+            std::vector<double> moduli (gridSize);
+            for (size_t m = 0; m < gridSize; ++m) {
+                double sumCos = 0.;
+                double sumSin = 0.;
+                for (size_t t = 0; t < _splineOrder; ++t) {
+                    const double arg = 2. * std::numbers::pi * static_cast<double>(m * t) / static_cast<double>(gridSize);
+                    sumCos += theta[t] * std::cos(arg);
+                    sumSin += theta[t] * std::sin(arg);
+                }
+                moduli[m] = sumCos * sumCos + sumSin * sumSin;
+            }
+            // Odd orders have a zero at the Nyquist frequency, interpolate like Essmann et al.
+            for (size_t m = 0; m < gridSize; ++m) {
+                if (moduli[m] < 1e-7) {
+                    moduli[m] = (moduli[(m + gridSize - 1) % gridSize] + moduli[(m + 1) % gridSize]) / 2.;
+                }
+            }
+
+            const double volume = _boxLength * _boxLength * _boxLength;
+            const double piSquaredOverAlphaSquared = std::numbers::pi * std::numbers::pi / (_alpha * _alpha);
+
+            for (size_t a = 0; a < gridSize; ++a) {
+                for (size_t b = 0; b < gridSize; ++b) {
+                    for (size_t c = 0; c < gridSize; ++c) {
+                        if (a == 0 and b == 0 and c == 0) {
+                            _influence(a, b, c) = 0.;
+                            continue;
+                        }
+                        const auto wave = [&](size_t index) {
+                            const double shifted = index <= gridSize / 2 ? static_cast<double>(index) : static_cast<double>(index) - static_cast<double>(gridSize);
+                            return shifted / _boxLength;
+                        };
+                        const double mSquared = wave(a) * wave(a) + wave(b) * wave(b) + wave(c) * wave(c);
+                        _influence(a, b, c) = std::exp(-piSquaredOverAlphaSquared * mSquared) / (std::numbers::pi * volume * mSquared)
+                                              / (moduli[a] * moduli[b] * moduli[c]);
+                    }
+                }
+            }
+        }
+
+        size_t _gridSize;
+
+        size_t _splineOrder;
+
+        double _alpha;
+
+        double _boxMin;
+
+        double _boxLength;
+
+        RealGrid _chargeGrid {};
+
+        RealGrid _potentialGrid {};
+
+        RealGrid _influence {};
+
+        fft::Grid _transformGrid {};
+
+        ScatterGrid _scatterGrid {};
+
+        autopas::utils::Timer _spreadTimer {};
+
+        autopas::utils::Timer _forwardFFTTimer {};
+
+        autopas::utils::Timer _convolutionTimer {};
+
+        autopas::utils::Timer _backwardFFTTimer {};
+
+        autopas::utils::Timer _interpolationTimer {};
+    };
+
+}
@@ -11,6 +11,11 @@
 #include "autopas/options/InteractionTypeOption.h"
 #include "autopas/options/Newton3Option.h"
 
+#include <iostream>
+#include <limits>
+
+#include "autopas/utils/ExceptionHandler.h"
+
 #include <utils/KokkosParticle.h>
 
 #include "Configuration.h"
@@ -24,39 +29,91 @@ namespace utils {
             autopasInstance.setAllowedContainers({autopas::options::ContainerOption::kokkosDirectSum});
             autopasInstance.setAllowedDataLayouts({autopas::options::DataLayoutOption::soa});
             autopasInstance.setAllowedContainerLayouts({autopas::options::DataLayoutOption::soa});
-            autopasInstance.setAllowedNewton3Options({autopas::options::Newton3Option::enabled});
-            autopasInstance.setAllowedInteractionTypeOptions({autopas::InteractionTypeOption::pairwise});
+            autopasInstance.setAllowedNewton3Options({config.getNewton3() ? autopas::options::Newton3Option::enabled : autopas::options::Newton3Option::disabled});
+            if (config.getTriwise()) {
+                autopasInstance.setAllowedInteractionTypeOptions({autopas::InteractionTypeOption::pairwise, autopas::InteractionTypeOption::triwise});
+            } else {
+                autopasInstance.setAllowedInteractionTypeOptions({autopas::InteractionTypeOption::pairwise});
+            }
 
             autopasInstance.setCutoff(config.getCutoff());
             autopasInstance.setBoxMin({config.getBoxMin(), config.getBoxMin(), config.getBoxMin()});
             autopasInstance.setBoxMax({config.getBoxMax(), config.getBoxMax(), config.getBoxMax()});
         }
 
+        /**
+         * Converts value to the narrower storage type T, throws if it does not fit.
+         */
+        template <class T>
+        T static checkedCast(size_t value, const std::string& what) {
+            if (value > static_cast<size_t>(std::numeric_limits<T>::max())) {
+                autopas::utils::ExceptionHandler::exception("Setup: {} {} exceeds the maximum {} of the particle storage type",
+                                                            what, value, static_cast<size_t>(std::numeric_limits<T>::max()));
+            }
+            return static_cast<T>(value);
+        }
+
+        void static printMemoryUsage(const Configuration& config) {
+            const size_t numParticles = config.getNumReplicas() * (config.getNumParticles() + config.getNumHalos());
+            const size_t bytesPerParticle = ParticleType::getBytesPerParticle();
+            std::cout << "Particle storage: " << bytesPerParticle << " bytes per particle, "
+                      << static_cast<double>(numParticles * bytesPerParticle) / (1024. * 1024.) << " MiB for "
+                      << numParticles << " particles" << std::endl;
+        }
+
         template <class Container>
         void static fillParticles(Container& autopasInstance, const Configuration& config) {
 
-            std::uniform_real_distribution<KokkosParticle::ParticleSoAFloatPrecision> distribution(config.getBoxMin(),config.getBoxMax());
-            std::uniform_real_distribution<KokkosParticle::ParticleSoAFloatPrecision> haloDistribution(config.getBoxMax() + 0.1 ,config.getBoxMax() + config.getCutoff());
-            std::default_random_engine generator;
+            // The largest id and replica id have to be representable, e.g. with 32 bit ids of CompactKokkosParticle
+            const size_t numIds = config.getNumReplicas() * (config.getNumParticles() + config.getNumHalos());
+            if (numIds > 0) {
+                checkedCast<typename ParticleType::IdStorageType>(numIds - 1, "particle id");
+            }
+            checkedCast<typename ParticleType::TypeIdStorageType>(config.getNumTypes() - 1, "type id");
+            if (config.getNumReplicas() > 0) {
+                checkedCast<typename ParticleType::ReplicaIdStorageType>(config.getNumReplicas() - 1, "replica id");
+            }
 
-            for (int i = 0; i < config.getNumParticles(); i++) {
-                KokkosParticle p {};
-                p.setF({0.,0.,0.});
-                p.setR({distribution(generator), distribution(generator), distribution(generator)});
-                p.setID(i);
-                p.setMass(1.);
+            std::uniform_real_distribution<ParticleType::ParticleSoAFloatPrecision> distribution(config.getBoxMin(),config.getBoxMax());
+            std::uniform_real_distribution<ParticleType::ParticleSoAFloatPrecision> haloDistribution(config.getBoxMax() + 0.1 ,config.getBoxMax() + config.getCutoff());
 
-                autopasInstance.addParticle(p);
-            }
+            const size_t particlesPerReplica = config.getNumParticles() + config.getNumHalos();
+
+            // Every replica fills the whole domain with its own seed. Added replica by replica, so the owned and the halo
+            // particles each form contiguous slices sorted by replica id, which the functors rely on
+            // (see replicaBound, checked by checkReplicaOrder in builds without NDEBUG)
+            for (size_t replica = 0; replica < config.getNumReplicas(); replica++) {
+                std::default_random_engine generator(config.getSeed() + replica);
+                const size_t idOffset = replica * particlesPerReplica;
+
+                for (int i = 0; i < config.getNumParticles(); i++) {
+                    ParticleType p {};
+                    p.setF({0.,0.,0.});
+                    p.setR({distribution(generator), distribution(generator), distribution(generator)});
+                    p.setID(idOffset + i);
+                    p.setMass(1.);
+                    p.setTypeId(i % config.getNumTypes());
+                    p.setReplicaId(replica);
+                    if (config.getSpme()) {
+                        p.setCharge(i % 2 == 0 ? config.getCharge() : -config.getCharge());
+                    }
+
+                    autopasInstance.addParticle(p);
+                }
 
-            for (int i = 0; i < config.getNumHalos(); i++) {
-                KokkosParticle p {};
-                p.setF({0.,0.,0.});
-                p.setR({haloDistribution(generator), distribution(generator), distribution(generator)});
-                p.setID(config.getNumParticles() + i);
-                p.setMass(1.);
+                for (int i = 0; i < config.getNumHalos(); i++) {
+                    ParticleType p {};
+                    p.setF({0.,0.,0.});
+                    p.setR({haloDistribution(generator), distribution(generator), distribution(generator)});
+                    p.setID(idOffset + config.getNumParticles() + i);
+                    p.setMass(1.);
+                    p.setTypeId(i % config.getNumTypes());
+                    p.setReplicaId(replica);
+                    // Halos stay uncharged: the SPME grid only holds the owned particles, and in the periodic box the
+                    // minimum image already provides their images, so both parts of the Ewald sum see the same charges
 
-                autopasInstance.addHaloParticle(p);
+                    autopasInstance.addHaloParticle(p);
+                }
             }
         }
     };
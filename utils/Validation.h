@@ -0,0 +1,479 @@
+/**
+ * @file Validation.h
+ * @date 19.10.2026
+ * @author Luis Gall
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <numbers>
+#include <vector>
+
+#include "autopas/options/IteratorBehavior.h"
+
+#include "KokkosParticle.h"
+
+namespace utils {
+
+    /**
+     * Particle of the reference implementation, all values in double precision on the host.
+     */
+    struct ReferenceParticle {
+        std::array<double, 3> r {};
+        std::array<double, 3> v {};
+        std::array<double, 3> f {};
+        double mass {1.};
+        double charge {0.};
+        size_t typeId {0};
+        size_t replicaId {0};
+        bool owned {true};
+    };
+
+    /**
+     * Physics of one FunctorKokkos variant, see makeOptions().
+     */
+    struct ReferenceOptions {
+        double cutoff {0.};
+        double boxLength {0.};
+        bool multiType {false};
+        bool periodic {false};
+        bool coulomb {false};
+        double ewaldAlpha {0.};
+        std::vector<double> epsilons {1.};
+        std::vector<double> sigmas {1.};
+        // Adds the reciprocal-space part and the self energy of the Ewald sum, the physics of --spme
+        bool reciprocal {false};
+        // Adds the Axilrod-Teller triplets with coefficient nu, the physics of --triwise
+        bool triwise {false};
+        double nu {0.};
+    };
+
+    /**
+     * Serial double-precision direct sum as ground truth for the optimized kernels, and the comparisons against it.
+     * Everything here is O(N^2) on one host thread, O(N M^3) with the reciprocal part and O(N^3) with the triplets, and
+     * meant for validation sizes only.
+     */
+    class Validation {
+    public:
+
+        /**
+         * Reference options with the template parameters of the given FunctorKokkos instantiation.
+         */
+        template <class Functor>
+        static ReferenceOptions makeOptions(double cutoff, double boxLength, const std::vector<double>& epsilons, const std::vector<double>& sigmas, double ewaldAlpha) {
+            return ReferenceOptions{cutoff, boxLength, Functor::usesMultiType, Functor::usesPeriodic, Functor::usesCoulomb, ewaldAlpha, epsilons, sigmas};
+        }
+
+        /**
+         * Overwrites the forces of targets with the forces exerted by sources, skipping the same index if both are the same set.
+         * @return potential energy, every owned target gets half of each of its pair energies like in FunctorKokkos
+         */
+        static double computeForces(std::vector<ReferenceParticle>& targets, const std::vector<ReferenceParticle>& sources, bool sameSet, const ReferenceOptions& options) {
+            const double cutoffSquared = options.cutoff * options.cutoff;
+            double energy = 0.;
+
+            for (size_t i = 0; i < targets.size(); ++i) {
+                auto& target = targets[i];
+                std::array<double, 3> force {0., 0., 0.};
+
+                for (size_t j = 0; j < sources.size(); ++j) {
+                    const auto& source = sources[j];
+                    if ((sameSet and i == j) or target.replicaId != source.replicaId) {
+                        continue;
+                    }
+
+                    std::array<double, 3> dr {};
+                    for (size_t d = 0; d < 3; ++d) {
+                        dr[d] = target.r[d] - source.r[d];
+                        if (options.periodic) {
+                            dr[d] -= options.boxLength * std::round(dr[d] / options.boxLength);
+                        }
+                    }
+                    const double dr2 = dr[0] * dr[0] + dr[1] * dr[1] + dr[2] * dr[2];
+                    if (dr2 > cutoffSquared) {
+                        continue;
+                    }
+
+                    double sigmaSquared = 1.;
+                    double epsilon = 1.;
+                    if (options.multiType) {
+                        const double sigma = (options.sigmas.at(target.typeId) + options.sigmas.at(source.typeId)) / 2.;
+                        sigmaSquared = sigma * sigma;
+                        epsilon = std::sqrt(options.epsilons.at(target.typeId) * options.epsilons.at(source.typeId));
+                    }
+
+                    const double lj2 = sigmaSquared / dr2;
+                    const double lj6 = lj2 * lj2 * lj2;
+                    const double lj12 = lj6 * lj6;
+                    double fac = 24. * epsilon * (2. * lj12 - lj6) / dr2;
+                    double upot = 4. * epsilon * (lj12 - lj6);
+
+                    if (options.coulomb) {
+                        const double dist = std::sqrt(dr2);
+                        const double chargeProduct = target.charge * source.charge;
+                        const double erfcTerm = chargeProduct * std::erfc(options.ewaldAlpha * dist) / dist;
+                        fac += (erfcTerm + chargeProduct * 2. / std::sqrt(std::numbers::pi) * options.ewaldAlpha
+                                * std::exp(-options.ewaldAlpha * options.ewaldAlpha * dr2)) / dr2;
+                        upot += erfcTerm;
+                    }
+
+                    for (size_t d = 0; d < 3; ++d) {
+                        force[d] += fac * dr[d];
+                    }
+                    if (target.owned) {
+                        energy += 0.5 * upot;
+                    }
+                }
+                target.f = force;
+            }
+            return energy;
+        }
+
+        /**
+         * All forces of the set, including the reciprocal-space part if options.reciprocal and the triplets if options.triwise.
+         * @return potential energy of all included terms
+         */
+        static double computeForces(std::vector<ReferenceParticle>& particles, const ReferenceOptions& options) {
+            const auto sources = particles;
+            double energy = computeForces(particles, sources, true, options);
+            if (options.reciprocal) {
+                energy += addReciprocalForces(particles, options) + computeSelfEnergy(particles, options);
+            }
+            if (options.triwise) {
+                energy += addTriwiseForces(particles, options);
+            }
+            return energy;
+        }
+
+        /**
+         * Axilrod-Teller forces of all triplets of a replica with all three distances within the cutoff, without minimum
+         * image like FunctorAxilrodTellerKokkos. The forces are central differences of the triplet energy, so they do
+         * not share the analytic gradient of the kernel. O(N^3).
+         * @return triplet energy, every owned particle gets a third of each of its triplet energies
+         */
+        static double addTriwiseForces(std::vector<ReferenceParticle>& particles, const ReferenceOptions& options) {
+            const double cutoffSquared = options.cutoff * options.cutoff;
+            using Position = std::array<double, 3>;
+            const auto distanceSquared = [](const Position& a, const Position& b) {
+                return (a[0] - b[0]) * (a[0] - b[0]) + (a[1] - b[1]) * (a[1] - b[1]) + (a[2] - b[2]) * (a[2] - b[2]);
+            };
+            // nu (1 + 3 cos(gamma_i) cos(gamma_j) cos(gamma_k)) / (r_ij r_jk r_ki)^3
+            const auto tripletEnergy = [&](const std::array<Position, 3>& r) {
+                const Position drIJ {r[1][0] - r[0][0], r[1][1] - r[0][1], r[1][2] - r[0][2]};
+                const Position drJK {r[2][0] - r[1][0], r[2][1] - r[1][1], r[2][2] - r[1][2]};
+                const Position drKI {r[0][0] - r[2][0], r[0][1] - r[2][1], r[0][2] - r[2][2]};
+                const auto dot = [](const Position& a, const Position& b) { return a[0] * b[0] + a[1] * b[1] + a[2] * b[2]; };
+                const double allDistsSquared = dot(drIJ, drIJ) * dot(drJK, drJK) * dot(drKI, drKI);
+                const double cosineProduct = -dot(drIJ, drKI) * dot(drIJ, drJK) * dot(drJK, drKI) / allDistsSquared;
+                return options.nu * (1. + 3. * cosineProduct) / (allDistsSquared * std::sqrt(allDistsSquared));
+            };
+            const double step = 1e-6 * options.cutoff;
+
+            double energy = 0.;
+            for (size_t i = 0; i < particles.size(); ++i) {
+                for (size_t j = i + 1; j < particles.size(); ++j) {
+                    if (particles[j].replicaId != particles[i].replicaId or distanceSquared(particles[i].r, particles[j].r) > cutoffSquared) {
+                        continue;
+                    }
+                    for (size_t k = j + 1; k < particles.size(); ++k) {
+                        if (particles[k].replicaId != particles[i].replicaId or distanceSquared(particles[j].r, particles[k].r) > cutoffSquared
+                            or distanceSquared(particles[k].r, particles[i].r) > cutoffSquared) {
+                            continue;
+                        }
+
+                        const std::array<size_t, 3> triplet {i, j, k};
+                        std::array<Position, 3> r {particles[i].r, particles[j].r, particles[k].r};
+                        // The cutoff is decided on the unperturbed positions, the differences never cross it
+                        for (size_t t = 0; t < 3; ++t) {
+                            for (size_t d = 0; d < 3; ++d) {
+                                const double original = r[t][d];
+                                r[t][d] = original + step;
+                                const double energyPlus = tripletEnergy(r);
+                                r[t][d] = original - step;
+                                const double energyMinus = tripletEnergy(r);
+                                r[t][d] = original;
+                                particles[triplet[t]].f[d] -= (energyPlus - energyMinus) / (2. * step);
+                            }
+                        }
+
+                        const double numOwned = (particles[i].owned ? 1. : 0.) + (particles[j].owned ? 1. : 0.) + (particles[k].owned ? 1. : 0.);
+                        energy += numOwned / 3. * tripletEnergy(r);
+                    }
+                }
+            }
+            return energy;
+        }
+
+        /**
+         * Reciprocal-space part of the Ewald sum as direct sum over the wave vectors m, the reference for SPME. Uses the
+         * same G(m) = exp(-pi^2 m^2 / alpha^2) / (pi V m^2) as SPME without the B-spline moduli, so only the
+         * interpolation error of the grid remains. Only owned particles carry charge, as in SPME. O(N M^3).
+         * @return reciprocal-space energy
+         */
+        static double addReciprocalForces(std::vector<ReferenceParticle>& particles, const ReferenceOptions& options) {
+            const double boxLength = options.boxLength;
+            const double volume = boxLength * boxLength * boxLength;
+            const double alpha = options.ewaldAlpha;
+            // The terms beyond mMax are below exp(-pi^2 mMax^2 / (alpha L)^2) = 1e-12 relative to G(0)
+            const int mMax = std::max(1, static_cast<int>(std::ceil(alpha * boxLength * std::sqrt(std::log(1e12)) / std::numbers::pi)));
+            const size_t width = 2 * mMax + 1;
+
+            // exp(2 pi i m r_d / L) per particle, dimension and m, the structure factor terms are products of three
+            std::vector<std::complex<double>> phases (particles.size() * 3 * width);
+            const auto phase = [&](size_t i, size_t d, int m) -> std::complex<double>& {
+                return phases[(i * 3 + d) * width + static_cast<size_t>(m + mMax)];
+            };
+            for (size_t i = 0; i < particles.size(); ++i) {
+                for (size_t d = 0; d < 3; ++d) {
+                    for (int m = -mMax; m <= mMax; ++m) {
+                        phase(i, d, m) = std::polar(1., 2. * std::numbers::pi * m * particles[i].r[d] / boxLength);
+                    }
+                }
+            }
+
+            double energy = 0.;
+            std::vector<std::complex<double>> terms (particles.size());
+            for (int mX = -mMax; mX <= mMax; ++mX) {
+                for (int mY = -mMax; mY <= mMax; ++mY) {
+                    for (int mZ = -mMax; mZ <= mMax; ++mZ) {
+                        if (mX == 0 and mY == 0 and mZ == 0) {
+                            continue;
+                        }
+                        const double mSquared = static_cast<double>(mX * mX + mY * mY + mZ * mZ) / (boxLength * boxLength);
+                        const double influence = std::exp(-std::numbers::pi * std::numbers::pi * mSquared / (alpha * alpha)) / (std::numbers::pi * volume * mSquared);
+
+                        std::complex<double> structureFactor {0., 0.};
+                        for (size_t i = 0; i < particles.size(); ++i) {
+                            terms[i] = particles[i].owned ? particles[i].charge * phase(i, 0, mX) * phase(i, 1, mY) * phase(i, 2, mZ) : 0.;
+                            structureFactor += terms[i];
+                        }
+                        energy += 0.5 * influence * std::norm(structureFactor);
+
+                        // F_i = -dE/dr_i = G(m) k Im(conj(S) q_i exp(i k r_i)) with k = 2 pi m / L
+                        const std::array<double, 3> k {2. * std::numbers::pi * mX / boxLength, 2. * std::numbers::pi * mY / boxLength, 2. * std::numbers::pi * mZ / boxLength};
+                        for (size_t i = 0; i < particles.size(); ++i) {
+                            if (not particles[i].owned) {
+                                continue;
+                            }
+                            const double magnitude = influence * std::imag(std::conj(structureFactor) * terms[i]);
+                            for (size_t d = 0; d < 3; ++d) {
+                                particles[i].f[d] += magnitude * k[d];
+                            }
+                        }
+                    }
+                }
+            }
+            return energy;
+        }
+
+        /**
+         * Constant self-interaction correction -alpha / sqrt(pi) * sum q_i^2 of the owned particles.
+         */
+        static double computeSelfEnergy(const std::vector<ReferenceParticle>& particles, const ReferenceOptions& options) {
+            double sumChargeSquared = 0.;
+            for (const auto& p : particles) {
+                if (p.owned) {
+                    sumChargeSquared += p.charge * p.charge;
+                }
+            }
+            return -options.ewaldAlpha / std::sqrt(std::numbers::pi) * sumChargeSquared;
+        }
+
+        /**
+         * Same velocity Verlet scheme as the simulation: drift with the old forces, force computation, kick with the
+         * mean of old and new forces. Halo particles stay in place.
+         * @param deltaT time step width per replica
+         */
+        static void integrate(std::vector<ReferenceParticle>& particles, const ReferenceOptions& options, const std::vector<double>& deltaT, size_t steps) {
+            std::vector<std::array<double, 3>> oldForces (particles.size());
+            for (size_t step = 0; step < steps; ++step) {
+                for (size_t i = 0; i < particles.size(); ++i) {
+                    auto& p = particles[i];
+                    oldForces[i] = p.f;
+                    if (not p.owned) {
+                        continue;
+                    }
+                    const double dt = deltaT.at(p.replicaId);
+                    for (size_t d = 0; d < 3; ++d) {
+                        p.r[d] += p.v[d] * dt + p.f[d] * dt * dt / (2. * p.mass);
+                    }
+                }
+
+                computeForces(particles, options);
+
+                for (size_t i = 0; i < particles.size(); ++i) {
+                    auto& p = particles[i];
+                    if (not p.owned) {
+                        continue;
+                    }
+                    const double dt = deltaT.at(p.replicaId);
+                    for (size_t d = 0; d < 3; ++d) {
+                        p.v[d] += (p.f[d] + oldForces[i][d]) * dt / (2. * p.mass);
+                    }
+                }
+            }
+        }
+
+        /**
+         * Kinetic plus potential energy of the owned particles, evaluated in double precision.
+         */
+        static double computeTotalEnergy(std::vector<ReferenceParticle> particles, const ReferenceOptions& options) {
+            double energy = computeForces(particles, options);
+            for (const auto& p : particles) {
+                if (p.owned) {
+                    energy += 0.5 * p.mass * (p.v[0] * p.v[0] + p.v[1] * p.v[1] + p.v[2] * p.v[2]);
+                }
+            }
+            return energy;
+        }
+
+        /**
+         * Largest deviation of a force vector of an owned particle, relative to the RMS reference force.
+         * Both lists have to be in the same order.
+         */
+        static double compareForces(const std::vector<ReferenceParticle>& reference, const std::vector<ReferenceParticle>& actual) {
+            return compareOwned(reference, actual, [](const ReferenceParticle& p) { return p.f; }, true);
+        }
+
+        /**
+         * Largest absolute deviation of the position of an owned particle.
+         */
+        static double comparePositions(const std::vector<ReferenceParticle>& reference, const std::vector<ReferenceParticle>& actual) {
+            return compareOwned(reference, actual, [](const ReferenceParticle& p) { return p.r; }, false);
+        }
+
+        static double relativeError(double reference, double actual) {
+            return std::abs(actual - reference) / std::max(std::abs(reference), 1e-12);
+        }
+
+        /**
+         * Copies all owned and halo particles of an AutoPas instance to the host, sorted by id.
+         * @param numIds upper bound of the particle ids
+         */
+        template <class ExecutionSpace, bool ForEachHost, class Container>
+        static std::vector<ReferenceParticle> snapshot(Container& autopasInstance, size_t numIds) {
+            const Columns<typename ExecutionSpace::memory_space> columns ("validationSnapshot", numIds, numColumns);
+
+            autopasInstance.template forEachKokkos<ExecutionSpace>(KOKKOS_LAMBDA(int i, const autopas::utils::KokkosStorage<ParticleType>& storage) {
+                const size_t id = storage.template operator()<ParticleType::AttributeNames::id, true, ForEachHost>(i);
+                columns(id, rX) = storage.template operator()<ParticleType::AttributeNames::posX, true, ForEachHost>(i);
+                columns(id, rY) = storage.template operator()<ParticleType::AttributeNames::posY, true, ForEachHost>(i);
+                columns(id, rZ) = storage.template operator()<ParticleType::AttributeNames::posZ, true, ForEachHost>(i);
+                columns(id, vX) = storage.template operator()<ParticleType::AttributeNames::velocityX, true, ForEachHost>(i);
+                columns(id, vY) = storage.template operator()<ParticleType::AttributeNames::velocityY, true, ForEachHost>(i);
+                columns(id, vZ) = storage.template operator()<ParticleType::AttributeNames::velocityZ, true, ForEachHost>(i);
+                columns(id, fX) = storage.template operator()<ParticleType::AttributeNames::forceX, true, ForEachHost>(i);
+                columns(id, fY) = storage.template operator()<ParticleType::AttributeNames::forceY, true, ForEachHost>(i);
+                columns(id, fZ) = storage.template operator()<ParticleType::AttributeNames::forceZ, true, ForEachHost>(i);
+                columns(id, mass) = storage.template operator()<ParticleType::AttributeNames::mass, true, ForEachHost>(i);
+                columns(id, charge) = storage.template operator()<ParticleType::AttributeNames::charge, true, ForEachHost>(i);
+                columns(id, typeId) = storage.template operator()<ParticleType::AttributeNames::typeId, true, ForEachHost>(i);
+                columns(id, replicaId) = storage.template operator()<ParticleType::AttributeNames::replicaId, true, ForEachHost>(i);
+                columns(id, owned) = isOwnedState(storage.template operator()<ParticleType::AttributeNames::ownershipState, true, ForEachHost>(i)) ? 1. : 0.;
+                columns(id, present) = 1.;
+            }, autopas::IteratorBehavior::ownedOrHalo);
+
+            return toParticles(columns);
+        }
+
+        /**
+         * Copies all non-dummy particles of a Kokkos SoA to the host, in SoA order.
+         */
+        template <class ExecutionSpace>
+        static std::vector<ReferenceParticle> snapshot(const typename ParticleType::KokkosSoAArraysType& soa) {
+            const Columns<typename ExecutionSpace::memory_space> columns ("validationSnapshot", soa.size(), numColumns);
+
+            Kokkos::parallel_for("validationSnapshot", Kokkos::RangePolicy<ExecutionSpace>(0, soa.size()), KOKKOS_LAMBDA(int i) {
+                const auto ownershipState = soa.template operator()<ParticleType::AttributeNames::ownershipState, true, false>(i);
+                if (isDummyState(ownershipState)) {
+                    return;
+                }
+                columns(i, rX) = soa.template operator()<ParticleType::AttributeNames::posX, true, false>(i);
+                columns(i, rY) = soa.template operator()<ParticleType::AttributeNames::posY, true, false>(i);
+                columns(i, rZ) = soa.template operator()<ParticleType::AttributeNames::posZ, true, false>(i);
+                columns(i, vX) = soa.template operator()<ParticleType::AttributeNames::velocityX, true, false>(i);
+                columns(i, vY) = soa.template operator()<ParticleType::AttributeNames::velocityY, true, false>(i);
+                columns(i, vZ) = soa.template operator()<ParticleType::AttributeNames::velocityZ, true, false>(i);
+                columns(i, fX) = soa.template operator()<ParticleType::AttributeNames::forceX, true, false>(i);
+                columns(i, fY) = soa.template operator()<ParticleType::AttributeNames::forceY, true, false>(i);
+                columns(i, fZ) = soa.template operator()<ParticleType::AttributeNames::forceZ, true, false>(i);
+                columns(i, mass) = soa.template operator()<ParticleType::AttributeNames::mass, true, false>(i);
+                columns(i, charge) = soa.template operator()<ParticleType::AttributeNames::charge, true, false>(i);
+                columns(i, typeId) = soa.template operator()<ParticleType::AttributeNames::typeId, true, false>(i);
+                columns(i, replicaId) = soa.template operator()<ParticleType::AttributeNames::replicaId, true, false>(i);
+                columns(i, owned) = isOwnedState(ownershipState) ? 1. : 0.;
+                columns(i, present) = 1.;
+            });
+
+            return toParticles(columns);
+        }
+
+    private:
+
+        enum Column : size_t { rX, rY, rZ, vX, vY, vZ, fX, fY, fZ, mass, charge, typeId, replicaId, owned, present, numColumns };
+
+        template <class MemSpace>
+        using Columns = Kokkos::View<double**, Kokkos::LayoutRight, MemSpace>;
+
+        template <class MemSpace>
+        static std::vector<ReferenceParticle> toParticles(const Columns<MemSpace>& columns) {
+            // Only the snapshot leaves the execution space
+            const auto host = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), columns);
+
+            std::vector<ReferenceParticle> particles;
+            for (size_t row = 0; row < host.extent(0); ++row) {
+                if (host(row, present) == 0.) {
+                    continue;
+                }
+                ReferenceParticle p {};
+                p.r = {host(row, rX), host(row, rY), host(row, rZ)};
+                p.v = {host(row, vX), host(row, vY), host(row, vZ)};
+                p.f = {host(row, fX), host(row, fY), host(row, fZ)};
+                p.mass = host(row, mass);
+                p.charge = host(row, charge);
+                p.typeId = static_cast<size_t>(host(row, typeId));
+                p.replicaId = static_cast<size_t>(host(row, replicaId));
+                p.owned = host(row, owned) != 0.;
+                particles.push_back(p);
+            }
+            return particles;
+        }
+
+        template <class Attribute>
+        static double compareOwned(const std::vector<ReferenceParticle>& reference, const std::vector<ReferenceParticle>& actual, Attribute attribute, bool relativeToRMS) {
+            double scale = 1.;
+            if (relativeToRMS) {
+                double sumSquares = 0.;
+                size_t numOwned = 0;
+                for (const auto& p : reference) {
+                    if (p.owned) {
+                        const auto value = attribute(p);
+                        sumSquares += value[0] * value[0] + value[1] * value[1] + value[2] * value[2];
+                        ++numOwned;
+                    }
+                }
+                scale = numOwned > 0 ? std::max(std::sqrt(sumSquares / numOwned), 1e-12) : 1.;
+            }
+
+            double maxError = 0.;
+            for (size_t i = 0; i < std::min(reference.size(), actual.size()); ++i) {
+                if (not reference[i].owned) {
+                    continue;
+                }
+                const auto expected = attribute(reference[i]);
+                const auto value = attribute(actual[i]);
+                const double error = std::sqrt((value[0] - expected[0]) * (value[0] - expected[0]) + (value[1] - expected[1]) * (value[1] - expected[1])
+                                               + (value[2] - expected[2]) * (value[2] - expected[2]));
+                maxError = std::max(maxError, error / scale);
+            }
+            // Particles lost or gained are a failure regardless of the values
+            return reference.size() == actual.size() ? maxError : std::numeric_limits<double>::infinity();
+        }
+    };
+
+}